@@ -36,6 +36,7 @@
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = { nullptr, nullptr };
@@ -473,6 +474,54 @@ uint64_t FileAccess::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return i;
 }
 
+uint64_t FileAccess::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	// Generic version, going through the cursor. Implementations able to read
+	// at a given position by themselves should override this. The lock keeps
+	// concurrent reads from moving the cursor under each other; the owner must
+	// not use the cursor until its reads are done.
+	MutexLock lock(buffer_at_mutex);
+	uint64_t prev_pos = get_position();
+	seek(p_offset);
+	uint64_t read = get_buffer(p_dst, p_length);
+	seek(prev_pos);
+	return read;
+}
+
+void FileAccess::_async_read_task(void *p_userdata) {
+	AsyncRead *async_read = (AsyncRead *)p_userdata;
+
+	uint64_t read = async_read->file->get_buffer_at(async_read->offset, async_read->dst, async_read->length);
+	if (async_read->r_read) {
+		*async_read->r_read = read;
+	}
+	if (async_read->callback) {
+		async_read->callback(async_read->userdata, read == async_read->length ? OK : ERR_FILE_EOF, read);
+	}
+
+	memdelete(async_read);
+}
+
+FileAccess::AsyncReadID FileAccess::get_buffer_async(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length, uint64_t *r_read, AsyncReadCallback p_callback, void *p_userdata) {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, WorkerThreadPool::INVALID_TASK_ID);
+
+	AsyncRead *async_read = memnew(AsyncRead);
+	async_read->file = Ref<FileAccess>(this);
+	async_read->offset = p_offset;
+	async_read->dst = p_dst;
+	async_read->length = p_length;
+	async_read->r_read = r_read;
+	async_read->callback = p_callback;
+	async_read->userdata = p_userdata;
+	// High priority, so reads share the pool's threads instead of each starting a low priority system thread.
+	return WorkerThreadPool::get_singleton()->add_native_task(&FileAccess::_async_read_task, async_read, true, "FileAccessAsyncRead");
+}
+
+void FileAccess::wait_for_async_read(AsyncReadID p_id) {
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(p_id);
+}
+
 Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	Vector<uint8_t> data;
 
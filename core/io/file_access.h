@@ -35,6 +35,7 @@
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
+#include "core/os/mutex.h"
 #include "core/string/ustring.h"
 #include "core/typedefs.h"
 
@@ -84,6 +85,8 @@ public:
 	};
 
 	typedef void (*FileCloseFailNotify)(const String &);
+	typedef void (*AsyncReadCallback)(void *p_userdata, Error p_error, uint64_t p_read);
+	typedef int64_t AsyncReadID;
 
 	typedef Ref<FileAccess> (*CreateFunc)();
 	bool big_endian = false;
@@ -121,6 +124,19 @@ private:
 
 	static Ref<FileAccess> _open(const String &p_path, ModeFlags p_mode_flags);
 
+	struct AsyncRead {
+		Ref<FileAccess> file;
+		uint64_t offset = 0;
+		uint8_t *dst = nullptr;
+		uint64_t length = 0;
+		uint64_t *r_read = nullptr;
+		AsyncReadCallback callback = nullptr;
+		void *userdata = nullptr;
+	};
+	static void _async_read_task(void *p_userdata);
+
+	BinaryMutex buffer_at_mutex;
+
 public:
 	static void set_file_close_fail_notify_callback(FileCloseFailNotify p_cbk) { close_fail_notify = p_cbk; }
 
@@ -149,6 +165,9 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual uint64_t get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length); ///< get an array of bytes from a given position, without moving the cursor; can be called from multiple threads, but the default implementation borrows the cursor, so don't seek or read through it meanwhile
+	AsyncReadID get_buffer_async(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length, uint64_t *r_read = nullptr, AsyncReadCallback p_callback = nullptr, void *p_userdata = nullptr); ///< like get_buffer_at(), in the background; any number of reads may be in flight, each must be awaited with wait_for_async_read() before using the cursor again
+	static void wait_for_async_read(AsyncReadID p_id);
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
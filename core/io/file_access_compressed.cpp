@@ -30,6 +30,7 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
 #include "core/string/print_string.h"
 
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
@@ -52,6 +53,70 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 		}                                                   \
 	}
 
+Vector<uint8_t> FileAccessCompressed::compress_blocks(const uint8_t *p_data, uint32_t p_size, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+
+	// Same layout as read by open_after_magic(), preceded and followed by the magic.
+	CharString mgc = (p_magic + "    ").substr(0, 4).ascii();
+	uint32_t bc = (p_size / p_block_size) + 1;
+	uint64_t header_size = 16 + bc * 4;
+
+	Vector<uint8_t> ret;
+	ret.resize(header_size + Compression::get_max_compressed_buffer_size(p_block_size, p_mode) * bc + 4);
+	uint8_t *w = ret.ptrw();
+
+	memcpy(w, mgc.get_data(), 4);
+	encode_uint32(p_mode, &w[4]);
+	encode_uint32(p_block_size, &w[8]);
+	encode_uint32(p_size, &w[12]);
+
+	uint64_t ofs = header_size;
+	for (uint32_t i = 0; i < bc; i++) {
+		uint32_t bl = i == (bc - 1) ? p_size % p_block_size : p_block_size;
+		int s = Compression::compress(&w[ofs], &p_data[i * p_block_size], bl, p_mode);
+		ERR_FAIL_COND_V(s < 0, Vector<uint8_t>());
+		encode_uint32(s, &w[16 + i * 4]);
+		ofs += s;
+	}
+	memcpy(&w[ofs], mgc.get_data(), 4);
+
+	ret.resize(ofs + 4);
+	return ret;
+}
+
+bool FileAccessCompressed::_load_block(uint32_t p_block) const {
+	read_block = p_block;
+	read_block_size = p_block == read_block_count - 1 ? read_total % block_size : block_size;
+	read_cache_tick++;
+
+	CachedBlock *target = &read_cache[0];
+	for (int i = 0; i < READ_CACHE_SIZE; i++) {
+		if (read_cache[i].block == p_block) {
+			read_cache[i].last_used = read_cache_tick;
+			read_ptr = read_cache[i].data.ptr();
+			return true;
+		}
+		if (read_cache[i].last_used < target->last_used) {
+			target = &read_cache[i];
+		}
+	}
+
+	// Not cached, replace the least recently used block.
+	target->data.resize(block_size);
+	f->seek(read_blocks[p_block].offset);
+	f->get_buffer(comp_buffer.ptrw(), read_blocks[p_block].csize);
+	int ret = Compression::decompress(target->data.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[p_block].csize, cmode);
+	if (ret == -1) {
+		target->block = UINT32_MAX;
+		target->last_used = 0;
+		return false;
+	}
+	target->block = p_block;
+	target->last_used = read_cache_tick;
+	read_ptr = target->data.ptr();
+	return true;
+}
+
 Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	f = p_base;
 	cmode = (Compression::Mode)f->get_32();
@@ -74,19 +139,18 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	}
 
 	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
-	at_end = false;
+	for (int i = 0; i < READ_CACHE_SIZE; i++) {
+		read_cache[i].block = UINT32_MAX;
+		read_cache[i].last_used = 0;
+	}
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
-
-	int ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
 	read_pos = 0;
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	bool ok = _load_block(0);
+	at_end = read_block_size == 0;
+
+	return ok ? OK : ERR_FILE_CORRUPT;
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -132,43 +196,17 @@ void FileAccessCompressed::_close() {
 
 	if (writing) {
 		//save block table and all compressed blocks
-
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		uint32_t bc = (write_max / block_size) + 1;
-
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		Vector<int> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
-		}
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+		Vector<uint8_t> data = compress_blocks(write_ptr, write_max, magic, cmode, block_size);
+		f->store_buffer(data.ptr(), data.size());
 
 		buffer.clear();
 
 	} else {
 		comp_buffer.clear();
-		buffer.clear();
+		for (int i = 0; i < READ_CACHE_SIZE; i++) {
+			read_cache[i] = CachedBlock();
+		}
+		read_ptr = nullptr;
 		read_blocks.clear();
 	}
 	f.unref();
@@ -211,12 +249,7 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
 			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				ERR_FAIL_COND_MSG(!_load_block(block_idx), "Compressed file is corrupt.");
 			}
 
 			read_pos = p_position % block_size;
@@ -273,18 +306,13 @@ uint8_t FileAccessCompressed::get_8() const {
 
 	read_pos++;
 	if (read_pos >= read_block_size) {
-		read_block++;
-
-		if (read_block < read_block_count) {
+		if (read_block + 1 < read_block_count) {
 			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			int total = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			ERR_FAIL_COND_V_MSG(total == -1, 0, "Compressed file is corrupt.");
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+			ERR_FAIL_COND_V_MSG(!_load_block(read_block + 1), 0, "Compressed file is corrupt.");
 			read_pos = 0;
-
+			// The last block is empty when the size is a multiple of the block size.
+			at_end = read_block_size == 0;
 		} else {
-			read_block--;
 			at_end = true;
 		}
 	}
@@ -302,27 +330,29 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
+	uint64_t dst_pos = 0;
+	while (dst_pos < p_length) {
+		uint64_t to_copy = MIN(p_length - dst_pos, (uint64_t)(read_block_size - read_pos));
+		memcpy(&p_dst[dst_pos], &read_ptr[read_pos], to_copy);
+		dst_pos += to_copy;
+		read_pos += to_copy;
 
-			if (read_block < read_block_count) {
+		if (read_pos >= read_block_size) {
+			if (read_block + 1 < read_block_count) {
 				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				ERR_FAIL_COND_V_MSG(!_load_block(read_block + 1), -1, "Compressed file is corrupt.");
 				read_pos = 0;
-
+				// The last block is empty when the size is a multiple of the block size.
+				at_end = read_block_size == 0;
 			} else {
-				read_block--;
 				at_end = true;
-				if (i + 1 < p_length) {
+			}
+
+			if (at_end) {
+				if (dst_pos < p_length) {
 					read_eof = true;
 				}
-				return i + 1;
+				return dst_pos;
 			}
 		}
 	}
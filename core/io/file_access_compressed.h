@@ -50,8 +50,18 @@ class FileAccessCompressed : public FileAccess {
 		uint64_t offset;
 	};
 
+	// Recently decompressed blocks, so seeking back and forth between a few places doesn't decompress the same blocks again.
+	struct CachedBlock {
+		uint32_t block = UINT32_MAX;
+		uint64_t last_used = 0;
+		Vector<uint8_t> data;
+	};
+	static const int READ_CACHE_SIZE = 4;
+	mutable CachedBlock read_cache[READ_CACHE_SIZE];
+	mutable uint64_t read_cache_tick = 0;
+
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	mutable const uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -64,9 +74,11 @@ class FileAccessCompressed : public FileAccess {
 	Ref<FileAccess> f;
 
 	void _close();
+	bool _load_block(uint32_t p_block) const;
 
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	static Vector<uint8_t> compress_blocks(const uint8_t *p_data, uint32_t p_size, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size);
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
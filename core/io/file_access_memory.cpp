@@ -149,6 +149,19 @@ uint64_t FileAccessMemory::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+uint64_t FileAccessMemory::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+	ERR_FAIL_NULL_V(data, -1);
+
+	uint64_t left = p_offset < length ? length - p_offset : 0;
+	uint64_t read = MIN(p_length, left);
+	if (read > 0) {
+		memcpy(p_dst, &data[p_offset], read);
+	}
+
+	return read;
+}
+
 Error FileAccessMemory::get_error() const {
 	return pos >= length ? ERR_FILE_EOF : OK;
 }
@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
@@ -40,6 +41,7 @@
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
 	for (int i = 0; i < sources.size(); i++) {
 		if (sources[i]->try_open_pack(p_path, p_replace_files, p_offset)) {
+			pack_paths.insert(p_path);
 			return OK;
 		}
 	}
@@ -47,14 +49,14 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	String simplified_path = p_path.simplify_path();
-	PathMD5 pmd5(simplified_path.md5_buffer());
 
-	bool exists = files.has(pmd5);
+	bool exists = files.has(simplified_path);
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -64,7 +66,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	pf.src = p_src;
 
 	if (!exists || p_replace_files) {
-		files[pmd5] = pf;
+		files[simplified_path] = pf;
 	}
 
 	if (!exists) {
@@ -201,7 +203,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION_MIN || version > PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
@@ -248,7 +250,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
 	}
 
 	return true;
@@ -337,6 +339,17 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+uint64_t FileAccessPack::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) {
+	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (p_offset >= pf.size) {
+		return 0;
+	}
+	// The pack file does the actual positional read, so this doesn't touch the cursor of this file either.
+	return f->get_buffer_at(off + p_offset, p_dst, MIN(p_length, pf.size - p_offset));
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
@@ -395,6 +408,26 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
+
+	if (pf.compressed) {
+		// Blocks are compressed independently, so seeking only decompresses the blocks actually read.
+		uint8_t magic[4];
+		f->get_buffer(magic, 4);
+		if (memcmp(magic, PACK_FILE_COMPRESSED_MAGIC, 4) != 0) {
+			f.unref();
+			ERR_FAIL_MSG("Compressed pack-referenced file '" + p_path + "' is corrupt.");
+		}
+
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		Error err = fac->open_after_magic(f);
+		if (err != OK) {
+			f.unref();
+			ERR_FAIL_MSG("Can't open compressed pack-referenced file '" + p_path + "'.");
+		}
+		f = fac;
+		off = 0;
+	}
 	pos = 0;
 	eof = false;
 }
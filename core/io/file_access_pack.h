@@ -40,15 +40,22 @@
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
-// The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+// The current packed file format version number, only needed by packs with compressed files.
+#define PACK_FORMAT_VERSION 3
+// The packed file format version number written when no file is compressed.
+#define PACK_FORMAT_VERSION_NO_COMPRESSION 2
+// The oldest packed file format version number that can still be read.
+#define PACK_FORMAT_VERSION_MIN 2
+// Magic of packed files stored compressed, in FileAccessCompressed's block layout (since version 3).
+#define PACK_FILE_COMPRESSED_MAGIC "GCPF"
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1,
 };
 
 class PackSource;
@@ -66,6 +73,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false; // If so, size is the uncompressed size.
 	};
 
 private:
@@ -76,29 +84,12 @@ private:
 		HashSet<String> files;
 	};
 
-	struct PathMD5 {
-		uint64_t a = 0;
-		uint64_t b = 0;
-
-		bool operator==(const PathMD5 &p_val) const {
-			return (a == p_val.a) && (b == p_val.b);
-		}
-		static uint32_t hash(const PathMD5 &p_val) {
-			uint32_t h = hash_murmur3_one_32(p_val.a);
-			return hash_fmix32(hash_murmur3_one_32(p_val.b, h));
-		}
-
-		PathMD5() {}
-
-		explicit PathMD5(const Vector<uint8_t> &p_buf) {
-			a = *((uint64_t *)&p_buf[0]);
-			b = *((uint64_t *)&p_buf[8]);
-		}
-	};
-
-	HashMap<PathMD5, PackedFile, PathMD5> files;
+	// Keyed by the simplified path. Lookups only hash it (djb2, without the UTF-8 conversion and MD5 used before)
+	// and compare the whole path when the hash matches, so paths with colliding hashes stay apart.
+	HashMap<String, PackedFile> files;
 
 	Vector<PackSource *> sources;
+	HashSet<String> pack_paths;
 
 	PackedDir *root = nullptr;
 
@@ -109,13 +100,15 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
+	// Mounted packs are never written to while they are in use, so file accesses may map them into memory.
+	bool is_pack_path(const String &p_path) const { return pack_paths.has(p_path); }
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
@@ -171,6 +164,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual uint64_t get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -189,9 +183,7 @@ public:
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
-	String simplified_path = p_path.simplify_path();
-	PathMD5 pmd5(simplified_path.md5_buffer());
-	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
+	HashMap<String, PackedFile>::Iterator E = files.find(p_path.simplify_path());
 	if (!E) {
 		return nullptr; //not found
 	}
@@ -203,7 +195,7 @@ Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
 }
 
 bool PackedData::has_path(const String &p_path) {
-	return files.has(PathMD5(p_path.simplify_path().md5_buffer()));
+	return files.has(p_path.simplify_path());
 }
 
 bool PackedData::has_directory(const String &p_path) {
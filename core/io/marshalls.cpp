@@ -59,6 +59,55 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define ENCODE_FLAG_64 1 << 16
 #define ENCODE_FLAG_OBJECT_AS_ID 1 << 16
 
+// Packed arrays are stored as little-endian words, so on little-endian hosts they can be copied as a whole.
+// The byte swap is its own inverse, so these work for both encoding and decoding.
+static void _copy_le32(void *p_dst, const void *p_src, int64_t p_count) {
+	if (p_count == 0) {
+		return;
+	}
+#ifdef BIG_ENDIAN_ENABLED
+	uint8_t *dst = (uint8_t *)p_dst;
+	const uint8_t *src = (const uint8_t *)p_src;
+	for (int64_t i = 0; i < p_count; i++) {
+		uint32_t word;
+		memcpy(&word, src + i * 4, 4);
+		word = BSWAP32(word);
+		memcpy(dst + i * 4, &word, 4);
+	}
+#else
+	memcpy(p_dst, p_src, p_count * 4);
+#endif
+}
+
+static void _copy_le64(void *p_dst, const void *p_src, int64_t p_count) {
+	if (p_count == 0) {
+		return;
+	}
+#ifdef BIG_ENDIAN_ENABLED
+	uint8_t *dst = (uint8_t *)p_dst;
+	const uint8_t *src = (const uint8_t *)p_src;
+	for (int64_t i = 0; i < p_count; i++) {
+		uint64_t word;
+		memcpy(&word, src + i * 8, 8);
+		word = BSWAP64(word);
+		memcpy(dst + i * 8, &word, 8);
+	}
+#else
+	memcpy(p_dst, p_src, p_count * 8);
+#endif
+}
+
+static void _copy_le_real(void *p_dst, const void *p_src, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	_copy_le64(p_dst, p_src, p_count);
+#else
+	_copy_le32(p_dst, p_src, p_count);
+#endif
+}
+
+static_assert(sizeof(Vector2) == sizeof(real_t) * 2 && sizeof(Vector3) == sizeof(real_t) * 3, "Vectors must be tightly packed to be copied as a whole.");
+static_assert(sizeof(Color) == sizeof(float) * 4, "Colors must be tightly packed to be copied as a whole.");
+
 static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 
@@ -788,10 +837,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -815,12 +861,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int32_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
-				int32_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_uint32(&buf[i * 4]);
-				}
+				_copy_le32(data.ptrw(), buf, count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -839,12 +881,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int64_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
-				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_uint64(&buf[i * 8]);
-				}
+				_copy_le64(data.ptrw(), buf, count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -863,12 +901,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<float> data;
 
 			if (count) {
-				//const float*rbuf=(const float*)buf;
 				data.resize(count);
-				float *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_float(&buf[i * 4]);
-				}
+				_copy_le32(data.ptrw(), buf, count);
 			}
 			r_variant = data;
 
@@ -889,10 +923,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_double(&buf[i * 8]);
-				}
+				_copy_le64(data.ptrw(), buf, count);
 			}
 			r_variant = data;
 
@@ -944,12 +975,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
+#ifdef REAL_T_IS_DOUBLE
+					_copy_le64(varray.ptrw(), buf, count * 2);
+#else
 					Vector2 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
 					}
+#endif
 
 					int adv = sizeof(double) * 2 * count;
 
@@ -969,12 +1004,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
+#ifndef REAL_T_IS_DOUBLE
+					_copy_le32(varray.ptrw(), buf, count * 2);
+#else
 					Vector2 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
 					}
+#endif
 
 					int adv = sizeof(float) * 2 * count;
 
@@ -1004,6 +1043,9 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
+#ifdef REAL_T_IS_DOUBLE
+					_copy_le64(varray.ptrw(), buf, count * 3);
+#else
 					Vector3 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
@@ -1011,6 +1053,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 						w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
 						w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
 					}
+#endif
 
 					int adv = sizeof(double) * 3 * count;
 
@@ -1030,6 +1073,9 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
+#ifndef REAL_T_IS_DOUBLE
+					_copy_le32(varray.ptrw(), buf, count * 3);
+#else
 					Vector3 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
@@ -1037,6 +1083,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 						w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
 						w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
 					}
+#endif
 
 					int adv = sizeof(float) * 3 * count;
 
@@ -1067,15 +1114,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				carray.resize(count);
-				Color *w = carray.ptrw();
-
-				for (int32_t i = 0; i < count; i++) {
-					// Colors should always be in single-precision.
-					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
-					w[i].g = decode_float(buf + i * 4 * 4 + 4 * 1);
-					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
-					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
-				}
+				// Colors should always be in single-precision.
+				_copy_le32(carray.ptrw(), buf, count * 4);
 
 				int adv = 4 * 4 * count;
 
@@ -1644,10 +1684,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int32_t *r = data.ptr();
-				for (int32_t i = 0; i < datalen; i++) {
-					encode_uint32(r[i], &buf[i * datasize]);
-				}
+				_copy_le32(buf, data.ptr(), datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1661,10 +1698,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int64_t *r = data.ptr();
-				for (int64_t i = 0; i < datalen; i++) {
-					encode_uint64(r[i], &buf[i * datasize]);
-				}
+				_copy_le64(buf, data.ptr(), datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1678,10 +1712,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const float *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_float(r[i], &buf[i * datasize]);
-				}
+				_copy_le32(buf, data.ptr(), datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1695,10 +1726,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const double *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_double(r[i], &buf[i * datasize]);
-				}
+				_copy_le64(buf, data.ptr(), datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1747,13 +1775,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector2 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					buf += sizeof(real_t) * 2;
-				}
+				_copy_le_real(buf, data.ptr(), len * 2);
+				buf += sizeof(real_t) * 2 * len;
 			}
 
 			r_len += sizeof(real_t) * 2 * len;
@@ -1771,14 +1794,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector3 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					buf += sizeof(real_t) * 3;
-				}
+				_copy_le_real(buf, data.ptr(), len * 3);
+				buf += sizeof(real_t) * 3 * len;
 			}
 
 			r_len += sizeof(real_t) * 3 * len;
@@ -1796,15 +1813,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Color c = data.get(i);
-
-					encode_float(c.r, &buf[0]);
-					encode_float(c.g, &buf[4]);
-					encode_float(c.b, &buf[8]);
-					encode_float(c.a, &buf[12]);
-					buf += 4 * 4; // Colors should always be in single-precision.
-				}
+				_copy_le32(buf, data.ptr(), len * 4); // Colors should always be in single-precision.
+				buf += 4 * 4 * len;
 			}
 
 			r_len += 4 * 4 * len;
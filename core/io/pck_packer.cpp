@@ -33,7 +33,7 @@
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION_NO_COMPRESSION
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -89,7 +89,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	file->store_32(PACK_FORMAT_VERSION_NO_COMPRESSION); // Files are never compressed by PCKPacker.
 	file->store_32(VERSION_MAJOR);
 	file->store_32(VERSION_MINOR);
 	file->store_32(VERSION_PATCH);
@@ -31,12 +31,15 @@
 #include "resource_format_binary.h"
 
 #include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -107,6 +110,16 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
+// Stands in for a resource reference while sub-resources are decoded ahead of time on other threads,
+// it is replaced by the actual resource on the loading thread, in file order.
+class ResourceLoaderBinaryDeferredObject : public RefCounted {
+public:
+	uint32_t type = 0;
+	uint32_t index = 0;
+	String ext_type;
+	String ext_path;
+};
+
 static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	if (f->real_is_double) {
 		if constexpr (sizeof(real_t) == 8) {
@@ -390,85 +403,42 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_OBJECT: {
 			uint32_t objtype = f->get_32();
+			uint32_t index = 0;
+			String exttype;
+			String path;
 
 			switch (objtype) {
 				case OBJECT_EMPTY: {
 					//do none
-
+					return OK;
 				} break;
-				case OBJECT_INTERNAL_RESOURCE: {
-					uint32_t index = f->get_32();
-					String path;
-
-					if (using_named_scene_ids) { // New format.
-						ERR_FAIL_INDEX_V((int)index, internal_resources.size(), ERR_PARSE_ERROR);
-						path = internal_resources[index].path;
-					} else {
-						path += res_path + "::" + itos(index);
-					}
-
-					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
-						WARN_PRINT(String("Couldn't load resource (no cache): " + path).utf8().get_data());
-						r_v = Variant();
-					} else {
-						r_v = internal_index_cache[path];
-					}
+				case OBJECT_INTERNAL_RESOURCE:
+				case OBJECT_EXTERNAL_RESOURCE_INDEX: {
+					index = f->get_32();
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE: {
 					//old file format, still around for compatibility
-
-					String exttype = get_unicode_string();
-					String path = get_unicode_string();
-
-					if (!path.contains("://") && path.is_relative_path()) {
-						// path is relative to file being loaded, so convert to a resource path
-						path = ProjectSettings::get_singleton()->localize_path(res_path.get_base_dir().path_join(path));
-					}
-
-					if (remaps.find(path)) {
-						path = remaps[path];
-					}
-
-					Ref<Resource> res = ResourceLoader::load(path, exttype);
-
-					if (res.is_null()) {
-						WARN_PRINT(String("Couldn't load resource: " + path).utf8().get_data());
-					}
-					r_v = res;
-
-				} break;
-				case OBJECT_EXTERNAL_RESOURCE_INDEX: {
-					//new file format, just refers to an index in the external list
-					int erindex = f->get_32();
-
-					if (erindex < 0 || erindex >= external_resources.size()) {
-						WARN_PRINT("Broken external resource! (index out of size)");
-						r_v = Variant();
-					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
-							Error err;
-							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
-							if (res.is_null()) {
-								if (!ResourceLoader::is_cleaning_tasks()) {
-									if (!ResourceLoader::get_abort_on_missing_resources()) {
-										ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
-									} else {
-										error = ERR_FILE_MISSING_DEPENDENCIES;
-										ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[erindex].path + ".");
-									}
-								}
-							} else {
-								r_v = res;
-							}
-						}
-					}
+					exttype = get_unicode_string();
+					path = get_unicode_string();
 				} break;
 				default: {
 					ERR_FAIL_V(ERR_FILE_CORRUPT);
 				} break;
 			}
+
+			if (defer_objects) {
+				Ref<ResourceLoaderBinaryDeferredObject> deferred;
+				deferred.instantiate();
+				deferred->type = objtype;
+				deferred->index = index;
+				deferred->ext_type = exttype;
+				deferred->ext_path = path;
+				r_v = deferred;
+				has_deferred_objects = true;
+				return OK;
+			}
+
+			return _parse_object(objtype, index, exttype, path, r_v);
 		} break;
 		case VARIANT_CALLABLE: {
 			r_v = Callable();
@@ -665,11 +635,220 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
+Error ResourceLoaderBinary::_parse_object(uint32_t p_type, uint32_t p_index, const String &p_ext_type, const String &p_ext_path, Variant &r_v) {
+	switch (p_type) {
+		case OBJECT_INTERNAL_RESOURCE: {
+			uint32_t index = p_index;
+			String path;
+
+			if (using_named_scene_ids) { // New format.
+				ERR_FAIL_INDEX_V((int)index, internal_resources.size(), ERR_PARSE_ERROR);
+				path = internal_resources[index].path;
+			} else {
+				path += res_path + "::" + itos(index);
+			}
+
+			//always use internal cache for loading internal resources
+			if (!internal_index_cache.has(path)) {
+				WARN_PRINT(String("Couldn't load resource (no cache): " + path).utf8().get_data());
+				r_v = Variant();
+			} else {
+				r_v = internal_index_cache[path];
+			}
+		} break;
+		case OBJECT_EXTERNAL_RESOURCE: {
+			//old file format, still around for compatibility
+
+			String exttype = p_ext_type;
+			String path = p_ext_path;
+
+			if (!path.contains("://") && path.is_relative_path()) {
+				// path is relative to file being loaded, so convert to a resource path
+				path = ProjectSettings::get_singleton()->localize_path(res_path.get_base_dir().path_join(path));
+			}
+
+			if (remaps.find(path)) {
+				path = remaps[path];
+			}
+
+			Ref<Resource> res = ResourceLoader::load(path, exttype);
+
+			if (res.is_null()) {
+				WARN_PRINT(String("Couldn't load resource: " + path).utf8().get_data());
+			}
+			r_v = res;
+
+		} break;
+		case OBJECT_EXTERNAL_RESOURCE_INDEX: {
+			//new file format, just refers to an index in the external list
+			int erindex = p_index;
+
+			if (erindex < 0 || erindex >= external_resources.size()) {
+				WARN_PRINT("Broken external resource! (index out of size)");
+				r_v = Variant();
+			} else {
+				Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
+				if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+					Error err;
+					Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
+					if (res.is_null()) {
+						if (!ResourceLoader::is_cleaning_tasks()) {
+							if (!ResourceLoader::get_abort_on_missing_resources()) {
+								ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
+							} else {
+								error = ERR_FILE_MISSING_DEPENDENCIES;
+								ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[erindex].path + ".");
+							}
+						}
+					} else {
+						r_v = res;
+					}
+				}
+			}
+		} break;
+		default: {
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		} break;
+	}
+
+	return OK;
+}
+
+Error ResourceLoaderBinary::_resolve_deferred_objects(Variant &r_v) {
+	switch (r_v.get_type()) {
+		case Variant::OBJECT: {
+			ResourceLoaderBinaryDeferredObject *deferred = Object::cast_to<ResourceLoaderBinaryDeferredObject>(r_v.get_validated_object());
+			if (deferred) {
+				Variant resolved;
+				Error err = _parse_object(deferred->type, deferred->index, deferred->ext_type, deferred->ext_path, resolved);
+				r_v = resolved;
+				return err;
+			}
+		} break;
+		case Variant::ARRAY: {
+			Array a = r_v;
+			for (int i = 0; i < a.size(); i++) {
+				Variant value = a[i];
+				if (value.get_type() == Variant::OBJECT || value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+					Error err = _resolve_deferred_objects(value);
+					ERR_FAIL_COND_V(err != OK, err);
+					a[i] = value;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			// Keys may be deferred too, so rebuild the dictionary keeping the order.
+			Dictionary d = r_v;
+			Dictionary resolved;
+			List<Variant> keys;
+			d.get_key_list(&keys);
+			for (const Variant &E : keys) {
+				Variant key = E;
+				Variant value = d[E];
+				Error err = _resolve_deferred_objects(key);
+				ERR_FAIL_COND_V(err != OK, err);
+				err = _resolve_deferred_objects(value);
+				ERR_FAIL_COND_V(err != OK, err);
+				resolved[key] = value;
+			}
+			r_v = resolved;
+		} break;
+		default: {
+		} break;
+	}
+
+	return OK;
+}
+
+Error ResourceLoaderBinary::_decode_resource(uint64_t p_offset, DecodedResource &r_decoded) {
+	f->seek(p_offset);
+	r_decoded.type = get_unicode_string();
+
+	int pc = f->get_32();
+	ERR_FAIL_COND_V(pc < 0, ERR_FILE_CORRUPT);
+	r_decoded.properties.resize(pc);
+
+	has_deferred_objects = false;
+	for (int i = 0; i < pc; i++) {
+		StringName name = _get_string();
+		if (name == StringName()) {
+			return ERR_FILE_CORRUPT;
+		}
+
+		r_decoded.properties[i].first = name;
+		Error err = parse_variant(r_decoded.properties[i].second);
+		if (err != OK) {
+			return err;
+		}
+	}
+	r_decoded.has_deferred_objects = has_deferred_objects;
+
+	// Not get_error(), memory files report the end of the file once it's reached, not only once it's read past.
+	return f->eof_reached() ? ERR_FILE_CORRUPT : OK;
+}
+
+void ResourceLoaderBinary::_decode_resources_chunk(uint32_t p_chunk, DecodedResource *p_decoded) {
+	// The main resource is always decoded on the loading thread.
+	uint32_t from = p_chunk * decode_chunk_size;
+	uint32_t to = MIN(from + decode_chunk_size, (uint32_t)internal_resources.size() - 1);
+
+	// Resources are stored back to back, so the chunk is read at once, without moving the cursor.
+	// The loading thread doesn't use the file until every chunk is done.
+	uint64_t begin = internal_resources[from].offset;
+	uint64_t end = internal_resources[to].offset;
+	if (end <= begin || end > f->get_length()) {
+		return; // The loading thread decodes these again, and reports the error.
+	}
+	Vector<uint8_t> data;
+	data.resize(end - begin);
+	if (f->get_buffer_at(begin, data.ptrw(), data.size()) != (uint64_t)data.size()) {
+		return;
+	}
+
+	// Each chunk reads through its own file, so it needs its own parsing state too.
+	Ref<FileAccessMemory> fm;
+	fm.instantiate();
+	fm->open_custom(data.ptr(), data.size());
+	ResourceLoaderBinary decoder;
+	decoder.f = fm;
+	decoder.f->set_big_endian(f->is_big_endian());
+	decoder.f->real_is_double = f->real_is_double;
+	decoder.local_path = local_path;
+	decoder.res_path = res_path;
+	decoder.ver_format = ver_format;
+	decoder.string_map = string_map;
+	decoder.using_named_scene_ids = using_named_scene_ids;
+	decoder.internal_resources = internal_resources;
+	decoder.defer_objects = true;
+
+	for (uint32_t i = from; i < to; i++) {
+		if (decoder._decode_resource(internal_resources[i].offset - begin, p_decoded[i]) != OK) {
+			return; // The loading thread decodes the rest again, and reports the error.
+		}
+		p_decoded[i].valid = true;
+	}
+}
+
 Error ResourceLoaderBinary::load() {
 	if (error != OK) {
 		return error;
 	}
 
+	// Files with many sub-resources are decoded on the WorkerThreadPool while dependencies load,
+	// resources are then created and linked on this thread in file order like before.
+	// Threaded loads already run as pool tasks, and waiting there would hold a pool thread, so they decode inline.
+	WorkerThreadPool::GroupID decode_group = WorkerThreadPool::INVALID_TASK_ID;
+	if (internal_resources.size() > PARALLEL_DECODE_MIN_RESOURCES && f->get_length() >= PARALLEL_DECODE_MIN_SIZE && WorkerThreadPool::get_caller_task_id() == WorkerThreadPool::INVALID_TASK_ID) {
+		uint32_t count = internal_resources.size() - 1;
+		uint32_t chunks = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), count);
+		if (chunks > 1) {
+			decode_chunk_size = (count + chunks - 1) / chunks;
+			chunks = (count + decode_chunk_size - 1) / decode_chunk_size;
+			decoded_resources.resize(count);
+			decode_group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ResourceLoaderBinary::_decode_resources_chunk, decoded_resources.ptr(), chunks, chunks, true, SNAME("ResourceLoaderBinaryDecode"));
+		}
+	}
+
 	for (int i = 0; i < external_resources.size(); i++) {
 		String path = external_resources[i].path;
 
@@ -689,11 +868,18 @@ Error ResourceLoaderBinary::load() {
 				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
 			} else {
 				error = ERR_FILE_MISSING_DEPENDENCIES;
+				if (decode_group != WorkerThreadPool::INVALID_TASK_ID) {
+					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(decode_group);
+				}
 				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
 			}
 		}
 	}
 
+	if (decode_group != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(decode_group);
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
@@ -727,11 +913,16 @@ Error ResourceLoaderBinary::load() {
 			}
 		}
 
-		uint64_t offset = internal_resources[i].offset;
-
-		f->seek(offset);
+		DecodedResource *decoded = (uint32_t)i < decoded_resources.size() && decoded_resources[i].valid ? &decoded_resources[i] : nullptr;
 
-		String t = get_unicode_string();
+		String t;
+		if (decoded) {
+			t = decoded->type;
+		} else {
+			uint64_t offset = internal_resources[i].offset;
+			f->seek(offset);
+			t = get_unicode_string();
+		}
 
 		Ref<Resource> res;
 
@@ -784,25 +975,38 @@ Error ResourceLoaderBinary::load() {
 			internal_index_cache[path] = res;
 		}
 
-		int pc = f->get_32();
+		int pc = decoded ? (int)decoded->properties.size() : f->get_32();
 
 		//set properties
 
 		Dictionary missing_resource_properties;
 
 		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+			StringName name;
+			Variant value;
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+			if (decoded) {
+				name = decoded->properties[j].first;
+				value = decoded->properties[j].second;
+				decoded->properties[j].second = Variant(); // Don't keep an extra reference to big arrays.
+				if (decoded->has_deferred_objects) {
+					error = _resolve_deferred_objects(value);
+					if (error) {
+						return error;
+					}
+				}
+			} else {
+				name = _get_string();
 
-			Variant value;
+				if (name == StringName()) {
+					error = ERR_FILE_CORRUPT;
+					ERR_FAIL_V(ERR_FILE_CORRUPT);
+				}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
+				error = parse_variant(value);
+				if (error) {
+					return error;
+				}
 			}
 
 			bool set_valid = true;
@@ -1528,7 +1732,7 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(Ref<FileAccess> f, int p_byt
 	}
 }
 
-void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint) {
+void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint, bool p_resolved) {
 	switch (p_property.get_type()) {
 		case Variant::NIL: {
 			f->store_32(VARIANT_NIL);
@@ -1778,6 +1982,19 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 		case Variant::OBJECT: {
 			f->store_32(VARIANT_OBJECT);
 			Ref<Resource> res = p_property;
+			if (p_resolved) {
+				// Everything was resolved when the snapshot was taken, the resource itself may be in use on another thread.
+				if (res.is_valid() && external_resources.has(res)) {
+					f->store_32(OBJECT_EXTERNAL_RESOURCE_INDEX);
+					f->store_32(external_resources[res]);
+				} else if (res.is_valid() && resource_map.has(res)) {
+					f->store_32(OBJECT_INTERNAL_RESOURCE);
+					f->store_32(resource_map[res]);
+				} else {
+					f->store_32(OBJECT_EMPTY);
+				}
+				return;
+			}
 			if (res.is_null() || res->get_meta(SNAME("_skip_save_"), false)) {
 				f->store_32(OBJECT_EMPTY);
 				return; // Don't save it.
@@ -1816,8 +2033,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			d.get_key_list(&keys);
 
 			for (const Variant &E : keys) {
-				write_variant(f, E, resource_map, external_resources, string_map);
-				write_variant(f, d[E], resource_map, external_resources, string_map);
+				write_variant(f, E, resource_map, external_resources, string_map, PropertyInfo(), p_resolved);
+				write_variant(f, d[E], resource_map, external_resources, string_map, PropertyInfo(), p_resolved);
 			}
 
 		} break;
@@ -1826,7 +2043,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Array a = p_property;
 			f->store_32(uint32_t(a.size()));
 			for (int i = 0; i < a.size(); i++) {
-				write_variant(f, a[i], resource_map, external_resources, string_map);
+				write_variant(f, a[i], resource_map, external_resources, string_map, PropertyInfo(), p_resolved);
 			}
 
 		} break;
@@ -2061,26 +2278,31 @@ static String _resource_get_class(Ref<Resource> p_resource) {
 	}
 }
 
-Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags) {
+Error ResourceFormatSaverBinaryInstance::_open(const String &p_path, Ref<FileAccess> &r_f) const {
 	Error err;
-	Ref<FileAccess> f;
-	if (p_flags & ResourceSaver::FLAG_COMPRESS) {
+	if (compress) {
 		Ref<FileAccessCompressed> fac;
 		fac.instantiate();
 		fac->configure("RSCC");
-		f = fac;
+		r_f = fac;
 		err = fac->open_internal(p_path, FileAccess::WRITE);
 	} else {
-		f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+		r_f = FileAccess::open(p_path, FileAccess::WRITE, &err);
 	}
 
 	ERR_FAIL_COND_V_MSG(err != OK, err, "Cannot create file '" + p_path + "'.");
+	return OK;
+}
+
+Error ResourceFormatSaverBinaryInstance::_snapshot(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags, bool p_detach) {
+	ERR_FAIL_COND_V(p_resource.is_null(), ERR_INVALID_PARAMETER);
 
 	relative_paths = p_flags & ResourceSaver::FLAG_RELATIVE_PATHS;
 	skip_editor = p_flags & ResourceSaver::FLAG_OMIT_EDITOR_PROPERTIES;
 	bundle_resources = p_flags & ResourceSaver::FLAG_BUNDLE_RESOURCES;
 	big_endian = p_flags & ResourceSaver::FLAG_SAVE_BIG_ENDIAN;
 	takeover_paths = p_flags & ResourceSaver::FLAG_REPLACE_SUBRESOURCE_PATHS;
+	compress = p_flags & ResourceSaver::FLAG_COMPRESS;
 
 	if (!p_path.begins_with("res://")) {
 		takeover_paths = false;
@@ -2091,60 +2313,23 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 
 	_find_resources(p_resource, true);
 
-	if (!(p_flags & ResourceSaver::FLAG_COMPRESS)) {
-		//save header compressed
-		static const uint8_t header[4] = { 'R', 'S', 'R', 'C' };
-		f->store_buffer(header, 4);
-	}
+	main_type = _resource_get_class(p_resource);
 
-	if (big_endian) {
-		f->store_32(1);
-		f->set_big_endian(true);
-	} else {
-		f->store_32(0);
-	}
-
-	f->store_32(0); //64 bits file, false for now
-	f->store_32(VERSION_MAJOR);
-	f->store_32(VERSION_MINOR);
-	f->store_32(FORMAT_VERSION);
-
-	if (f->get_error() != OK && f->get_error() != ERR_FILE_EOF) {
-		return ERR_CANT_CREATE;
-	}
-
-	save_unicode_string(f, _resource_get_class(p_resource));
-	f->store_64(0); //offset to import metadata
-
-	String script_class;
-	{
-		uint32_t format_flags = FORMAT_FLAG_NAMED_SCENE_IDS | FORMAT_FLAG_UIDS;
+	format_flags = FORMAT_FLAG_NAMED_SCENE_IDS | FORMAT_FLAG_UIDS;
 #ifdef REAL_T_IS_DOUBLE
-		format_flags |= FORMAT_FLAG_REAL_T_IS_DOUBLE;
+	format_flags |= FORMAT_FLAG_REAL_T_IS_DOUBLE;
 #endif
-		if (!p_resource->is_class("PackedScene")) {
-			Ref<Script> s = p_resource->get_script();
-			if (s.is_valid()) {
-				script_class = s->get_global_name();
-				if (!script_class.is_empty()) {
-					format_flags |= ResourceFormatSaverBinaryInstance::FORMAT_FLAG_HAS_SCRIPT_CLASS;
-				}
+	if (!p_resource->is_class("PackedScene")) {
+		Ref<Script> s = p_resource->get_script();
+		if (s.is_valid()) {
+			script_class = s->get_global_name();
+			if (!script_class.is_empty()) {
+				format_flags |= ResourceFormatSaverBinaryInstance::FORMAT_FLAG_HAS_SCRIPT_CLASS;
 			}
 		}
-
-		f->store_32(format_flags);
-	}
-	ResourceUID::ID uid = ResourceSaver::get_resource_id_for_path(p_path, true);
-	f->store_64(uid);
-	if (!script_class.is_empty()) {
-		save_unicode_string(f, script_class);
 	}
 
-	for (int i = 0; i < ResourceFormatSaverBinaryInstance::RESERVED_FIELDS; i++) {
-		f->store_32(0); // reserved
-	}
-
-	List<ResourceData> resources;
+	main_uid = ResourceSaver::get_resource_id_for_path(p_path, true);
 
 	Dictionary missing_resource_properties = p_resource->get_meta(META_MISSING_RESOURCES, Dictionary());
 
@@ -2193,6 +2378,11 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 						continue;
 					}
 
+					if (p_detach && (p.value.get_type() == Variant::ARRAY || p.value.get_type() == Variant::DICTIONARY)) {
+						// Containers are shared by reference, the owner may keep modifying them while the snapshot is written.
+						p.value = p.value.duplicate(true);
+					}
+
 					p.pi = F;
 
 					rd.properties.push_back(p);
@@ -2201,13 +2391,6 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 		}
 	}
 
-	f->store_32(strings.size()); //string table size
-	for (int i = 0; i < strings.size(); i++) {
-		save_unicode_string(f, strings[i]);
-	}
-
-	// save external resource table
-	f->store_32(external_resources.size()); //amount of external resources
 	Vector<Ref<Resource>> save_order;
 	save_order.resize(external_resources.size());
 
@@ -2215,17 +2398,15 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 		save_order.write[E.value] = E.key;
 	}
 
+	external_table.resize(save_order.size());
 	for (int i = 0; i < save_order.size(); i++) {
-		save_unicode_string(f, save_order[i]->get_save_class());
+		ExternalResource &er = external_table.write[i];
+		er.type = save_order[i]->get_save_class();
 		String res_path = save_order[i]->get_path();
-		res_path = relative_paths ? local_path.path_to_file(res_path) : res_path;
-		save_unicode_string(f, res_path);
-		ResourceUID::ID ruid = ResourceSaver::get_resource_id_for_path(save_order[i]->get_path(), false);
-		f->store_64(ruid);
+		er.path = relative_paths ? local_path.path_to_file(res_path) : res_path;
+		er.uid = ResourceSaver::get_resource_id_for_path(res_path, false);
 	}
-	// save internal resource table
-	f->store_32(saved_resources.size()); //amount of internal resources
-	Vector<uint64_t> ofs_pos;
+
 	HashSet<String> used_unique_ids;
 
 	for (Ref<Resource> &r : saved_resources) {
@@ -2240,7 +2421,6 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 		}
 	}
 
-	HashMap<Ref<Resource>, int> resource_map;
 	int res_index = 0;
 	for (Ref<Resource> &r : saved_resources) {
 		if (r->is_built_in()) {
@@ -2258,7 +2438,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 				used_unique_ids.insert(new_id);
 			}
 
-			save_unicode_string(f, "local://" + r->get_scene_unique_id());
+			internal_paths.push_back("local://" + r->get_scene_unique_id());
 			if (takeover_paths) {
 				r->set_path(p_path + "::" + r->get_scene_unique_id(), true);
 			}
@@ -2266,11 +2446,70 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 			r->set_edited(false);
 #endif
 		} else {
-			save_unicode_string(f, r->get_path()); //actual external
+			internal_paths.push_back(r->get_path()); //actual external
 		}
+		internal_resources[r] = res_index++;
+	}
+
+	return OK;
+}
+
+Error ResourceFormatSaverBinaryInstance::_write(Ref<FileAccess> f, bool p_detached) {
+	if (!compress) {
+		//save header compressed
+		static const uint8_t header[4] = { 'R', 'S', 'R', 'C' };
+		f->store_buffer(header, 4);
+	}
+
+	if (big_endian) {
+		f->store_32(1);
+		f->set_big_endian(true);
+	} else {
+		f->store_32(0);
+	}
+
+	f->store_32(0); //64 bits file, false for now
+	f->store_32(VERSION_MAJOR);
+	f->store_32(VERSION_MINOR);
+	f->store_32(FORMAT_VERSION);
+
+	if (f->get_error() != OK && f->get_error() != ERR_FILE_EOF) {
+		return ERR_CANT_CREATE;
+	}
+
+	save_unicode_string(f, main_type);
+	f->store_64(0); //offset to import metadata
+
+	f->store_32(format_flags);
+	f->store_64(main_uid);
+	if (!script_class.is_empty()) {
+		save_unicode_string(f, script_class);
+	}
+
+	for (int i = 0; i < ResourceFormatSaverBinaryInstance::RESERVED_FIELDS; i++) {
+		f->store_32(0); // reserved
+	}
+
+	f->store_32(strings.size()); //string table size
+	for (int i = 0; i < strings.size(); i++) {
+		save_unicode_string(f, strings[i]);
+	}
+
+	// save external resource table
+	f->store_32(external_table.size()); //amount of external resources
+	for (const ExternalResource &er : external_table) {
+		save_unicode_string(f, er.type);
+		save_unicode_string(f, er.path);
+		f->store_64(er.uid);
+	}
+
+	// save internal resource table
+	f->store_32(internal_paths.size()); //amount of internal resources
+	Vector<uint64_t> ofs_pos;
+	for (const String &internal_path : internal_paths) {
+		save_unicode_string(f, internal_path);
 		ofs_pos.push_back(f->get_position());
 		f->store_64(0); //offset in 64 bits
-		resource_map[r] = res_index++;
 	}
 
 	Vector<uint64_t> ofs_table;
@@ -2283,7 +2522,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 
 		for (const Property &p : rd.properties) {
 			f->store_32(p.name_idx);
-			write_variant(f, p.value, resource_map, external_resources, string_map, p.pi);
+			write_variant(f, p.value, internal_resources, external_resources, string_map, p.pi, p_detached);
 		}
 	}
 
@@ -2303,6 +2542,141 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 	return OK;
 }
 
+Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags) {
+	compress = p_flags & ResourceSaver::FLAG_COMPRESS;
+
+	Ref<FileAccess> f;
+	Error err = _open(p_path, f);
+	if (err != OK) {
+		return err;
+	}
+
+	err = _snapshot(p_path, p_resource, p_flags, false);
+	if (err != OK) {
+		return err;
+	}
+
+	return _write(f, false);
+}
+
+Error ResourceFormatSaverBinaryInstance::take_snapshot(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags) {
+	return _snapshot(p_path, p_resource, p_flags, true);
+}
+
+Error ResourceFormatSaverBinaryInstance::write_snapshot() {
+	Ref<FileAccess> f;
+	Error err = _open(path, f);
+	if (err != OK) {
+		return err;
+	}
+
+	return _write(f, true);
+}
+
+static void _hash_snapshot_bytes(CryptoCore::SHA256Context &r_ctx, const void *p_data, size_t p_size) {
+	r_ctx.update((const uint8_t *)p_data, p_size);
+}
+
+static void _hash_snapshot_uint(CryptoCore::SHA256Context &r_ctx, uint64_t p_value) {
+	_hash_snapshot_bytes(r_ctx, &p_value, sizeof(p_value));
+}
+
+static void _hash_snapshot_string(CryptoCore::SHA256Context &r_ctx, const String &p_string) {
+	CharString utf8 = p_string.utf8();
+	_hash_snapshot_uint(r_ctx, utf8.length());
+	_hash_snapshot_bytes(r_ctx, utf8.get_data(), utf8.length());
+}
+
+static void _hash_snapshot_variant(CryptoCore::SHA256Context &r_ctx, const Variant &p_value, const HashMap<Ref<Resource>, int> &p_internal, const HashMap<Ref<Resource>, int> &p_external) {
+	_hash_snapshot_uint(r_ctx, p_value.get_type());
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			// Hashed the way write_variant() stores it, by index in the resource tables.
+			Ref<Resource> res = p_value;
+			const int *external_index = res.is_valid() ? p_external.getptr(res) : nullptr;
+			const int *internal_index = res.is_valid() ? p_internal.getptr(res) : nullptr;
+			if (external_index) {
+				_hash_snapshot_uint(r_ctx, OBJECT_EXTERNAL_RESOURCE_INDEX);
+				_hash_snapshot_uint(r_ctx, *external_index);
+			} else if (internal_index) {
+				_hash_snapshot_uint(r_ctx, OBJECT_INTERNAL_RESOURCE);
+				_hash_snapshot_uint(r_ctx, *internal_index);
+			} else {
+				_hash_snapshot_uint(r_ctx, OBJECT_EMPTY);
+			}
+		} break;
+		case Variant::ARRAY: {
+			Array a = p_value;
+			_hash_snapshot_uint(r_ctx, a.size());
+			for (int i = 0; i < a.size(); i++) {
+				_hash_snapshot_variant(r_ctx, a[i], p_internal, p_external);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_value;
+			List<Variant> keys;
+			d.get_key_list(&keys);
+			_hash_snapshot_uint(r_ctx, keys.size());
+			for (const Variant &E : keys) {
+				_hash_snapshot_variant(r_ctx, E, p_internal, p_external);
+				_hash_snapshot_variant(r_ctx, d[E], p_internal, p_external);
+			}
+		} break;
+		default: {
+			int len = 0;
+			Error err = encode_variant(p_value, nullptr, len);
+			ERR_FAIL_COND(err != OK);
+			Vector<uint8_t> buffer;
+			buffer.resize(len);
+			encode_variant(p_value, buffer.ptrw(), len);
+			_hash_snapshot_bytes(r_ctx, buffer.ptr(), len);
+		} break;
+	}
+}
+
+String ResourceFormatSaverBinaryInstance::get_snapshot_hash() const {
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+
+	_hash_snapshot_string(ctx, path);
+	_hash_snapshot_uint(ctx, compress);
+	_hash_snapshot_uint(ctx, big_endian);
+	_hash_snapshot_string(ctx, main_type);
+	_hash_snapshot_string(ctx, script_class);
+	_hash_snapshot_uint(ctx, format_flags);
+	_hash_snapshot_uint(ctx, main_uid);
+
+	_hash_snapshot_uint(ctx, strings.size());
+	for (const StringName &E : strings) {
+		_hash_snapshot_string(ctx, E);
+	}
+
+	_hash_snapshot_uint(ctx, external_table.size());
+	for (const ExternalResource &er : external_table) {
+		_hash_snapshot_string(ctx, er.type);
+		_hash_snapshot_string(ctx, er.path);
+		_hash_snapshot_uint(ctx, er.uid);
+	}
+
+	_hash_snapshot_uint(ctx, internal_paths.size());
+	for (const String &internal_path : internal_paths) {
+		_hash_snapshot_string(ctx, internal_path);
+	}
+
+	for (const ResourceData &rd : resources) {
+		_hash_snapshot_string(ctx, rd.type);
+		_hash_snapshot_uint(ctx, rd.properties.size());
+		for (const Property &p : rd.properties) {
+			_hash_snapshot_uint(ctx, p.name_idx);
+			_hash_snapshot_variant(ctx, p.value, internal_resources, external_resources);
+		}
+	}
+
+	unsigned char hash[32];
+	ctx.finish(hash);
+	return String::hex_encode_buffer(hash, 32);
+}
+
 Error ResourceFormatSaverBinaryInstance::set_uid(const String &p_path, ResourceUID::ID p_uid) {
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
 	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_OPEN, "Cannot open file '" + p_path + "'.");
@@ -2425,6 +2799,93 @@ Error ResourceFormatSaverBinary::save(const Ref<Resource> &p_resource, const Str
 	return saver.save(local_path, p_resource, p_flags);
 }
 
+void ResourceFormatSaverBinary::_background_save(void *p_userdata) {
+	BackgroundSave *bs = static_cast<BackgroundSave *>(p_userdata);
+	bs->error = bs->saver.write_snapshot();
+}
+
+Error ResourceFormatSaverBinary::save_in_background(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags, bool p_skip_unchanged) {
+	String local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+
+	// Saves of the same file must not overlap, finish the previous one first.
+	wait_for_background_save(local_path);
+
+	BackgroundSave *bs = memnew(BackgroundSave);
+
+	Error err = bs->saver.take_snapshot(local_path, p_resource, p_flags);
+	if (err != OK) {
+		memdelete(bs);
+		return err;
+	}
+
+	if (p_skip_unchanged) {
+		bs->snapshot_hash = bs->saver.get_snapshot_hash();
+	}
+
+	MutexLock lock(background_mutex);
+
+	if (background_saves.has(local_path)) {
+		memdelete(bs);
+		ERR_FAIL_V_MSG(ERR_BUSY, "Resource '" + local_path + "' is already being saved in the background from another thread.");
+	}
+
+	if (p_skip_unchanged) {
+		const String *last_hash = last_snapshot_hashes.getptr(local_path);
+		if (last_hash && *last_hash == bs->snapshot_hash && FileAccess::exists(local_path)) {
+			memdelete(bs);
+			return OK;
+		}
+	}
+
+	bs->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceFormatSaverBinary::_background_save, bs, true, "Save resource " + local_path);
+	background_saves[local_path] = bs;
+	return OK;
+}
+
+Error ResourceFormatSaverBinary::wait_for_background_save(const String &p_path) {
+	String local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+
+	BackgroundSave *bs = nullptr;
+	{
+		MutexLock lock(background_mutex);
+		BackgroundSave **E = background_saves.getptr(local_path);
+		if (!E) {
+			return OK;
+		}
+		bs = *E;
+		background_saves.erase(local_path);
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(bs->task_id);
+	Error err = bs->error;
+
+	{
+		MutexLock lock(background_mutex);
+		if (!bs->snapshot_hash.is_empty() && err == OK) {
+			last_snapshot_hashes[local_path] = bs->snapshot_hash;
+		} else {
+			last_snapshot_hashes.erase(local_path);
+		}
+	}
+
+	memdelete(bs);
+	return err;
+}
+
+void ResourceFormatSaverBinary::finish_background_saves() {
+	List<String> paths;
+	{
+		MutexLock lock(background_mutex);
+		for (const KeyValue<String, BackgroundSave *> &E : background_saves) {
+			paths.push_back(E.key);
+		}
+	}
+
+	for (const String &E : paths) {
+		wait_for_background_save(E);
+	}
+}
+
 Error ResourceFormatSaverBinary::set_uid(const String &p_path, ResourceUID::ID p_uid) {
 	String local_path = ProjectSettings::get_singleton()->localize_path(p_path);
 	ResourceFormatSaverBinaryInstance saver;
@@ -2448,3 +2909,10 @@ ResourceFormatSaverBinary *ResourceFormatSaverBinary::singleton = nullptr;
 ResourceFormatSaverBinary::ResourceFormatSaverBinary() {
 	singleton = this;
 }
+
+ResourceFormatSaverBinary::~ResourceFormatSaverBinary() {
+	finish_background_saves();
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
@@ -34,6 +34,8 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -89,6 +91,27 @@ class ResourceLoaderBinary {
 	friend class ResourceFormatLoaderBinary;
 
 	Error parse_variant(Variant &r_v);
+	Error _parse_object(uint32_t p_type, uint32_t p_index, const String &p_ext_type, const String &p_ext_path, Variant &r_v);
+
+	// Sub-resources can be decoded ahead of time on other threads, with resource references left as placeholders.
+	static const int PARALLEL_DECODE_MIN_RESOURCES = 4;
+	static const uint64_t PARALLEL_DECODE_MIN_SIZE = 256 * 1024;
+
+	struct DecodedResource {
+		String type;
+		LocalVector<Pair<StringName, Variant>> properties;
+		bool has_deferred_objects = false;
+		bool valid = false;
+	};
+
+	bool defer_objects = false;
+	bool has_deferred_objects = false;
+	LocalVector<DecodedResource> decoded_resources;
+	uint32_t decode_chunk_size = 0;
+
+	Error _decode_resource(uint64_t p_offset, DecodedResource &r_decoded);
+	void _decode_resources_chunk(uint32_t p_chunk, DecodedResource *p_decoded);
+	Error _resolve_deferred_objects(Variant &r_v);
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
@@ -157,11 +180,32 @@ class ResourceFormatSaverBinaryInstance {
 		List<Property> properties;
 	};
 
+	struct ExternalResource {
+		String type;
+		String path;
+		ResourceUID::ID uid = ResourceUID::INVALID_ID;
+	};
+
+	// Snapshot of the resource graph, gathered by _snapshot() and consumed by _write().
+	bool compress = false;
+	String main_type;
+	String script_class;
+	uint32_t format_flags = 0;
+	ResourceUID::ID main_uid = ResourceUID::INVALID_ID;
+	Vector<ExternalResource> external_table;
+	Vector<String> internal_paths;
+	List<ResourceData> resources;
+	HashMap<Ref<Resource>, int> internal_resources;
+
 	static void _pad_buffer(Ref<FileAccess> f, int p_bytes);
 	void _find_resources(const Variant &p_variant, bool p_main = false);
 	static void save_unicode_string(Ref<FileAccess> f, const String &p_string, bool p_bit_on_len = false);
 	int get_string_index(const String &p_string);
 
+	Error _open(const String &p_path, Ref<FileAccess> &r_f) const;
+	Error _snapshot(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags, bool p_detach);
+	Error _write(Ref<FileAccess> f, bool p_detached);
+
 public:
 	enum {
 		FORMAT_FLAG_NAMED_SCENE_IDS = 1,
@@ -173,19 +217,43 @@ public:
 		RESERVED_FIELDS = 11
 	};
 	Error save(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags = 0);
+	// Split version of save(): take_snapshot() must run on the thread that owns the resources,
+	// write_snapshot() only touches the snapshot and can run on any thread afterwards.
+	Error take_snapshot(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags = 0);
+	Error write_snapshot();
+	String get_snapshot_hash() const;
 	Error set_uid(const String &p_path, ResourceUID::ID p_uid);
-	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo());
+	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo(), bool p_resolved = false);
 };
 
 class ResourceFormatSaverBinary : public ResourceFormatSaver {
+	struct BackgroundSave {
+		ResourceFormatSaverBinaryInstance saver;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		String snapshot_hash; // Only taken when unchanged saves are skipped.
+		Error error = OK;
+	};
+
+	Mutex background_mutex;
+	HashMap<String, BackgroundSave *> background_saves;
+	HashMap<String, String> last_snapshot_hashes; // Hash of the last background save of each path, to skip unchanged ones.
+
+	static void _background_save(void *p_userdata);
+
 public:
 	static ResourceFormatSaverBinary *singleton;
 	virtual Error save(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags = 0);
+	// Gathers the resource graph on the calling thread and encodes and writes it on the WorkerThreadPool.
+	// With p_skip_unchanged, nothing is written if the graph is identical to the last background save of this path.
+	Error save_in_background(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags = 0, bool p_skip_unchanged = false);
+	Error wait_for_background_save(const String &p_path);
+	void finish_background_saves();
 	virtual Error set_uid(const String &p_path, ResourceUID::ID p_uid);
 	virtual bool recognize(const Ref<Resource> &p_resource) const;
 	virtual void get_recognized_extensions(const Ref<Resource> &p_resource, List<String> *p_extensions) const;
 
 	ResourceFormatSaverBinary();
+	~ResourceFormatSaverBinary();
 };
 
 #endif // RESOURCE_FORMAT_BINARY_H
@@ -421,6 +421,15 @@ void ResourceFormatImporter::get_importers(List<Ref<ResourceImporter>> *r_import
 	}
 }
 
+bool ResourceFormatImporter::has_script_importers() const {
+	for (int i = 0; i < importers.size(); i++) {
+		if (importers[i]->get_script_instance()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 Ref<ResourceImporter> ResourceFormatImporter::get_importer_by_extension(const String &p_extension) const {
 	Ref<ResourceImporter> importer;
 	float priority = 0;
@@ -88,6 +88,7 @@ public:
 	Ref<ResourceImporter> get_importer_by_extension(const String &p_extension) const;
 	void get_importers_for_extension(const String &p_extension, List<Ref<ResourceImporter>> *r_importers);
 	void get_importers(List<Ref<ResourceImporter>> *r_importers);
+	bool has_script_importers() const;
 
 	bool are_import_settings_valid(const String &p_path) const;
 	String get_import_settings_hash() const;
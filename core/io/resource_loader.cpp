@@ -292,6 +292,10 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		thread_load_mutex.unlock();
 		return;
 	}
+	load_task.start_usec = OS::get_singleton()->get_ticks_usec();
+	if (print_load_order) {
+		print_line(vformat("Resource load started: %s (%s priority).", load_task.local_path, load_task.high_priority ? "high" : "normal"));
+	}
 	thread_load_mutex.unlock();
 
 	// Thread-safe either if it's the current thread or a brand new one.
@@ -316,14 +320,22 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		set_current_thread_safe_for_nodes(true);
 	}
 
+	if (load_task.prefetch_dependencies) {
+		_prefetch_dependencies(load_task);
+	}
+
 	Ref<Resource> res = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
 	if (mq_override) {
 		mq_override->flush();
 	}
 
+	// Released once unlocked, as releasing a token may need to lock or await its task.
+	Vector<Ref<LoadToken>> prefetch_tokens;
+
 	thread_load_mutex.lock();
 
 	load_task.resource = res;
+	SWAP(prefetch_tokens, load_task.prefetch_tokens);
 
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
 	if (load_task.error != OK) {
@@ -374,8 +386,14 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		}
 	}
 
+	if (print_load_order) {
+		print_line(vformat("Resource load %s: %s in %.2f ms.", load_task.status == THREAD_LOAD_LOADED ? "finished" : "failed", load_task.local_path, (OS::get_singleton()->get_ticks_usec() - load_task.start_usec) / 1000.0));
+	}
+
 	thread_load_mutex.unlock();
 
+	prefetch_tokens.clear();
+
 	if (load_nesting == 0) {
 		if (mq_override) {
 			memdelete(mq_override);
@@ -384,6 +402,41 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	}
 }
 
+void ResourceLoader::_prefetch_dependencies(ThreadLoadTask &p_load_task) {
+	// Start loading the direct dependencies right away, instead of when the loader reaches them.
+	// They prefetch their own dependencies once they start, so the graph is walked in parallel, one level per task.
+	Vector<Ref<LoadToken>> tokens;
+
+	List<String> dependencies;
+	get_dependencies(p_load_task.local_path, &dependencies);
+
+	for (const String &E : dependencies) {
+		String dep_path = E.get_slice("::", 0);
+		ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(dep_path);
+		if (uid != ResourceUID::INVALID_ID) {
+			if (ResourceUID::get_singleton()->has_id(uid)) {
+				dep_path = ResourceUID::get_singleton()->get_id_path(uid);
+			} else if (E.get_slice_count("::") >= 3) {
+				dep_path = E.get_slice("::", 2);
+			} else {
+				continue;
+			}
+		}
+		if (dep_path.is_empty() || dep_path == p_load_task.local_path || ResourceCache::has(dep_path)) {
+			continue; // Already loaded, so are its own dependencies.
+		}
+
+		// Loads already in progress are shared rather than started again, which also stops cycles.
+		Ref<LoadToken> token = _load_start(dep_path, "", LOAD_THREAD_DISTRIBUTE, p_load_task.cache_mode, p_load_task.high_priority);
+		if (token.is_valid()) {
+			tokens.push_back(token);
+		}
+	}
+
+	MutexLock thread_load_lock(thread_load_mutex);
+	p_load_task.prefetch_tokens = tokens;
+}
+
 static String _validate_local_path(const String &p_path) {
 	ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -395,7 +448,7 @@ static String _validate_local_path(const String &p_path) {
 	}
 }
 
-Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode) {
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode, bool p_high_priority) {
 	thread_load_mutex.lock();
 	if (user_load_tokens.has(p_path)) {
 		print_verbose("load_threaded_request(): Another threaded load for resource path '" + p_path + "' has been initiated. Not an error.");
@@ -406,7 +459,7 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	user_load_tokens[p_path] = nullptr;
 	thread_load_mutex.unlock();
 
-	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode);
+	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, p_high_priority);
 	if (token.is_valid()) {
 		thread_load_mutex.lock();
 		token->user_path = p_path;
@@ -437,8 +490,9 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 	return res;
 }
 
-Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode) {
+Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_high_priority) {
 	String local_path = _validate_local_path(p_path);
+	bool high_priority = p_high_priority;
 
 	Ref<LoadToken> load_token;
 	bool must_not_register = false;
@@ -461,6 +515,14 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			}
 		}
 
+		if (load_nesting > 0 && load_paths_stack->size()) {
+			// Loads triggered by another one inherit its priority.
+			HashMap<String, ThreadLoadTask>::Iterator E = thread_load_tasks.find(load_paths_stack->get(load_paths_stack->size() - 1));
+			if (E) {
+				high_priority = high_priority || E->value.high_priority;
+			}
+		}
+
 		load_token.instantiate();
 		load_token->local_path = local_path;
 
@@ -474,6 +536,9 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
 			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			load_task.high_priority = high_priority;
+			// Loads requested from outside another load, and the ones they prefetch, prefetch their own dependencies.
+			load_task.prefetch_dependencies = load_task.use_sub_threads && load_nesting == 0 && p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE;
 			if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
@@ -500,10 +565,14 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 
 		run_on_current_thread = must_not_register || p_thread_mode == LOAD_THREAD_FROM_CURRENT;
 
+		if (print_load_order) {
+			print_line(vformat("Resource load queued: %s (%s priority%s).", local_path, high_priority ? "high" : "normal", run_on_current_thread ? ", current thread" : ""));
+		}
+
 		if (run_on_current_thread) {
 			load_task_ptr->thread_id = Thread::get_caller_id();
 		} else {
-			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, load_task_ptr);
+			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, load_task_ptr, high_priority);
 		}
 	}
 
@@ -759,6 +828,15 @@ void ResourceLoader::remove_resource_format_loader(Ref<ResourceFormatLoader> p_f
 	--loader_count;
 }
 
+bool ResourceLoader::has_script_loaders() {
+	for (int i = 0; i < loader_count; i++) {
+		if (loader[i]->get_script_instance()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 int ResourceLoader::get_import_order(const String &p_path) {
 	String local_path = _path_remap(_validate_local_path(p_path));
 
@@ -1186,6 +1264,7 @@ DependencyErrorNotify ResourceLoader::dep_err_notify = nullptr;
 bool ResourceLoader::create_missing_resources_if_class_unavailable = false;
 bool ResourceLoader::abort_on_missing_resource = true;
 bool ResourceLoader::timestamp_on_load = false;
+bool ResourceLoader::print_load_order = false;
 
 thread_local int ResourceLoader::load_nesting = 0;
 thread_local WorkerThreadPool::TaskID ResourceLoader::caller_task_id = 0;
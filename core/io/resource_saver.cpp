@@ -31,6 +31,7 @@
 #include "resource_saver.h"
 #include "core/config/project_settings.h"
 #include "core/io/file_access.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/object/script_language.h"
 
@@ -153,6 +154,58 @@ Error ResourceSaver::save(const Ref<Resource> &p_resource, const String &p_path,
 	return err;
 }
 
+Error ResourceSaver::save_in_background(const Ref<Resource> &p_resource, const String &p_path, uint32_t p_flags, bool p_skip_unchanged) {
+	String path = p_path;
+	if (path.is_empty()) {
+		path = p_resource->get_path();
+	}
+	ERR_FAIL_COND_V_MSG(path.is_empty(), ERR_INVALID_PARAMETER, "Can't save resource to empty path. Provide non-empty path or a Resource with non-empty resource_path.");
+
+	for (int i = 0; i < saver_count; i++) {
+		if (!saver[i]->recognize(p_resource)) {
+			continue;
+		}
+
+		if (!saver[i]->recognize_path(p_resource, path)) {
+			continue;
+		}
+
+		ResourceFormatSaverBinary *binary_saver = Object::cast_to<ResourceFormatSaverBinary>(saver[i].ptr());
+		if (!binary_saver) {
+			// Only the binary format can write a snapshot of the resource, other formats are saved right away.
+			return save(p_resource, path, p_flags);
+		}
+
+		String old_path = p_resource->get_path();
+
+		Ref<Resource> rwcopy = p_resource;
+		if (p_flags & FLAG_CHANGE_PATH) {
+			rwcopy->set_path(ProjectSettings::get_singleton()->localize_path(path));
+		}
+
+		// The snapshot is taken right away, so the resource can be modified as soon as this returns.
+		Error err = binary_saver->save_in_background(p_resource, path, p_flags, p_skip_unchanged);
+
+		if (p_flags & FLAG_CHANGE_PATH) {
+			rwcopy->set_path(old_path);
+		}
+
+#ifdef TOOLS_ENABLED
+		if (err == OK) {
+			((Resource *)p_resource.ptr())->set_edited(false);
+		}
+#endif
+		return err;
+	}
+
+	return ERR_FILE_UNRECOGNIZED;
+}
+
+Error ResourceSaver::wait_for_background_save(const String &p_path) {
+	ERR_FAIL_NULL_V(ResourceFormatSaverBinary::singleton, ERR_UNAVAILABLE);
+	return ResourceFormatSaverBinary::singleton->wait_for_background_save(p_path);
+}
+
 Error ResourceSaver::set_uid(const String &p_path, ResourceUID::ID p_uid) {
 	String path = p_path;
 
@@ -85,6 +85,10 @@ public:
 	};
 
 	static Error save(const Ref<Resource> &p_resource, const String &p_path = "", uint32_t p_flags = (uint32_t)FLAG_NONE);
+	// Like save(), but binary resources are written on the WorkerThreadPool; wait_for_background_save() returns the result.
+	// With p_skip_unchanged, nothing is written if the resource is the same as in the last background save of this path.
+	static Error save_in_background(const Ref<Resource> &p_resource, const String &p_path = "", uint32_t p_flags = (uint32_t)FLAG_NONE, bool p_skip_unchanged = false);
+	static Error wait_for_background_save(const String &p_path);
 	static void get_recognized_extensions(const Ref<Resource> &p_resource, List<String> *p_extensions);
 	static void add_resource_format_saver(Ref<ResourceFormatSaver> p_format_saver, bool p_at_front = false);
 	static void remove_resource_format_saver(Ref<ResourceFormatSaver> p_format_saver);
@@ -43,6 +43,8 @@ void WorkerThreadPool::Task::free_template_userdata() {
 
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
+static thread_local WorkerThreadPool::TaskID current_task_id = WorkerThreadPool::INVALID_TASK_ID;
+
 void WorkerThreadPool::_process_task_queue() {
 	task_mutex.lock();
 	Task *task = task_queue.first()->self();
@@ -139,6 +141,8 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			task_mutex.unlock();
 		}
 	} else {
+		TaskID prev_task_id = current_task_id; // In case this is recursively called.
+		current_task_id = p_task->self;
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
 		} else if (p_task->template_userdata) {
@@ -147,6 +151,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		} else {
 			p_task->callable.call();
 		}
+		current_task_id = prev_task_id;
 
 		task_mutex.lock();
 		p_task->completed = true;
@@ -273,6 +278,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	// Get a free task
 	Task *task = task_allocator.alloc();
 	TaskID id = last_task++;
+	task->self = id;
 	task->callable = p_callable;
 	task->native_func = p_func;
 	task->native_func_userdata = p_userdata;
@@ -290,6 +296,10 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() {
+	return current_task_id;
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	task_mutex.lock();
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -72,6 +72,7 @@ private:
 	};
 
 	struct Task {
+		TaskID self = INVALID_TASK_ID; // Not set for tasks of groups.
 		Callable callable;
 		void (*native_func)(void *) = nullptr;
 		void (*native_group_func)(void *, uint32_t) = nullptr;
@@ -178,6 +179,8 @@ public:
 
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
+	// The task running on the calling thread, or INVALID_TASK_ID if none (or if it belongs to a group).
+	static TaskID get_caller_task_id();
 
 	template <class C, class M, class U>
 	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
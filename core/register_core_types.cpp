@@ -381,6 +381,9 @@ void unregister_core_types() {
 
 	// Destroy singletons in reverse order to ensure dependencies are not broken.
 
+	// Background saves run on the WorkerThreadPool, so they must be done before it goes away.
+	resource_saver_binary->finish_background_saves();
+
 	memdelete(worker_thread_pool);
 
 	memdelete(_engine_debugger);
@@ -32,15 +32,112 @@
 
 #if defined(UNIX_ENABLED)
 
+#include "core/io/file_access_pack.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+// Files can be truncated or rewritten while the editor has them open (e.g. on reimport),
+// which would fault on a mapping. Exported projects don't change their resources or packs.
+#if defined(TOOLS_ENABLED) || defined(WEB_ENABLED)
+static bool use_mmap = false;
+#else
+static bool use_mmap = true;
+#endif
+
+void FileAccessUnix::set_use_mmap(bool p_enable) {
+	use_mmap = p_enable;
+}
+
+bool FileAccessUnix::is_using_mmap() {
+	return use_mmap;
+}
+
+struct FileAccessUnix::SharedMapping {
+	uint64_t device = 0;
+	uint64_t inode = 0;
+	uint64_t size = 0;
+	int64_t modified_time = 0;
+	uint8_t *data = nullptr;
+	uint32_t refcount = 0;
+};
+
+bool FileAccessUnix::_is_read_only_source() const {
+	// Only map files nothing writes to while the project runs: the resources of an exported project and mounted packs.
+	// Anything else (e.g. user:// saves) can be truncated in place by a write access, and reads from the mapping would fault.
+	if (get_access_type() == ACCESS_RESOURCES) {
+		return true;
+	}
+	return PackedData::get_singleton() && PackedData::get_singleton()->is_pack_path(path_src);
+}
+
+Mutex FileAccessUnix::mmap_mutex;
+HashMap<Pair<uint64_t, uint64_t>, FileAccessUnix::SharedMapping *, PairHash<uint64_t, uint64_t>> FileAccessUnix::shared_mappings;
+
+void FileAccessUnix::_map(int p_fd) {
+	struct stat fst = {};
+	if (fstat(p_fd, &fst) != 0 || !S_ISREG(fst.st_mode) || (uint64_t)fst.st_size < MMAP_MIN_SIZE || (sizeof(void *) == 4 && (uint64_t)fst.st_size > MMAP_MAX_SIZE_32_BITS)) {
+		return;
+	}
+
+	const Pair<uint64_t, uint64_t> key(fst.st_dev, fst.st_ino);
+	MutexLock lock(mmap_mutex);
+
+	HashMap<Pair<uint64_t, uint64_t>, SharedMapping *, PairHash<uint64_t, uint64_t>>::Iterator E = shared_mappings.find(key);
+	// A file changed in place gets a new mapping, the old one stays valid for the accesses using it.
+	if (E && E->value->size == (uint64_t)fst.st_size && E->value->modified_time == (int64_t)fst.st_mtime) {
+		shared_mapping = E->value;
+	} else {
+		void *data = mmap(nullptr, fst.st_size, PROT_READ, MAP_PRIVATE, p_fd, 0);
+		if (data == MAP_FAILED) {
+			return;
+		}
+		shared_mapping = memnew(SharedMapping);
+		shared_mapping->device = fst.st_dev;
+		shared_mapping->inode = fst.st_ino;
+		shared_mapping->size = fst.st_size;
+		shared_mapping->modified_time = fst.st_mtime;
+		shared_mapping->data = (uint8_t *)data;
+		shared_mappings[key] = shared_mapping;
+	}
+
+	shared_mapping->refcount++;
+	mapped = shared_mapping->data;
+	mapped_length = shared_mapping->size;
+	mapped_pos = 0;
+}
+
+void FileAccessUnix::_unmap() {
+	MutexLock lock(mmap_mutex);
+
+	shared_mapping->refcount--;
+	if (shared_mapping->refcount == 0) {
+		const Pair<uint64_t, uint64_t> key(shared_mapping->device, shared_mapping->inode);
+		HashMap<Pair<uint64_t, uint64_t>, SharedMapping *, PairHash<uint64_t, uint64_t>>::Iterator E = shared_mappings.find(key);
+		if (E && E->value == shared_mapping) {
+			shared_mappings.remove(E);
+		}
+		munmap(shared_mapping->data, shared_mapping->size);
+		memdelete(shared_mapping);
+	}
+
+	shared_mapping = nullptr;
+	mapped = nullptr;
+	mapped_length = 0;
+	mapped_pos = 0;
+}
+
+uint32_t FileAccessUnix::get_shared_mapping_count() {
+	MutexLock lock(mmap_mutex);
+	return shared_mappings.size();
+}
+
 void FileAccessUnix::check_errors() const {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
@@ -132,6 +229,10 @@ Error FileAccessUnix::open_internal(const String &p_path, int p_mode_flags) {
 		fcntl(fd, F_SETFD, opts | FD_CLOEXEC);
 	}
 
+	if (fd != -1 && p_mode_flags == READ && use_mmap && _is_read_only_source()) {
+		_map(fd);
+	}
+
 	last_error = OK;
 	flags = p_mode_flags;
 	return OK;
@@ -142,6 +243,10 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (shared_mapping) {
+		_unmap();
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -177,6 +282,10 @@ void FileAccessUnix::seek(uint64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
 	last_error = OK;
+	if (mapped) {
+		mapped_pos = p_position;
+		return;
+	}
 	if (fseeko(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -185,6 +294,12 @@ void FileAccessUnix::seek(uint64_t p_position) {
 void FileAccessUnix::seek_end(int64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped) {
+		ERR_FAIL_COND(p_position < 0 && (uint64_t)-p_position > mapped_length);
+		mapped_pos = mapped_length + p_position;
+		return;
+	}
+
 	if (fseeko(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -193,6 +308,10 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 uint64_t FileAccessUnix::get_position() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped) {
+		return mapped_pos;
+	}
+
 	int64_t pos = ftello(f);
 	if (pos < 0) {
 		check_errors();
@@ -204,6 +323,10 @@ uint64_t FileAccessUnix::get_position() const {
 uint64_t FileAccessUnix::get_length() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped) {
+		return mapped_length;
+	}
+
 	int64_t pos = ftello(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseeko(f, 0, SEEK_END), 0);
@@ -220,6 +343,14 @@ bool FileAccessUnix::eof_reached() const {
 
 uint8_t FileAccessUnix::get_8() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
+	if (mapped) {
+		if (mapped_pos >= mapped_length) {
+			last_error = ERR_FILE_EOF;
+			return 0;
+		}
+		return mapped[mapped_pos++];
+	}
+
 	uint8_t b;
 	if (fread(&b, 1, 1, f) == 0) {
 		check_errors();
@@ -232,11 +363,101 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
 
+	if (mapped) {
+		uint64_t available = mapped_pos < mapped_length ? mapped_length - mapped_pos : 0;
+		uint64_t read = MIN(p_length, available);
+		memcpy(p_dst, mapped + mapped_pos, read);
+		mapped_pos += read;
+		if (read < p_length) {
+			last_error = ERR_FILE_EOF;
+		}
+		return read;
+	}
+
 	uint64_t read = fread(p_dst, 1, p_length, f);
 	check_errors();
 	return read;
 }
 
+uint64_t FileAccessUnix::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
+
+	if (mapped) {
+		uint64_t available = p_offset < mapped_length ? mapped_length - p_offset : 0;
+		uint64_t read = MIN(p_length, available);
+		memcpy(p_dst, mapped + p_offset, read);
+		return read;
+	}
+
+	if (flags != READ) {
+		// Writes may still be buffered by stdio, go through the cursor instead.
+		return FileAccess::get_buffer_at(p_offset, p_dst, p_length);
+	}
+
+	// pread() doesn't use nor move the stdio cursor, so it's safe to call from multiple threads.
+	int fd = fileno(f);
+	uint64_t read = 0;
+	while (read < p_length) {
+		ssize_t r = pread(fd, p_dst + read, p_length - read, p_offset + read);
+		if (r < 0 && errno == EINTR) {
+			continue;
+		}
+		if (r <= 0) {
+			break;
+		}
+		read += r;
+	}
+	return read;
+}
+
+// Read multi-byte values with a single read instead of one per byte, missing bytes at the end of the file read as zero.
+
+uint16_t FileAccessUnix::get_16() const {
+	uint16_t res = 0;
+	get_buffer((uint8_t *)&res, sizeof(uint16_t));
+#ifdef BIG_ENDIAN_ENABLED
+	if (!big_endian) {
+		res = BSWAP16(res);
+	}
+#else
+	if (big_endian) {
+		res = BSWAP16(res);
+	}
+#endif
+	return res;
+}
+
+uint32_t FileAccessUnix::get_32() const {
+	uint32_t res = 0;
+	get_buffer((uint8_t *)&res, sizeof(uint32_t));
+#ifdef BIG_ENDIAN_ENABLED
+	if (!big_endian) {
+		res = BSWAP32(res);
+	}
+#else
+	if (big_endian) {
+		res = BSWAP32(res);
+	}
+#endif
+	return res;
+}
+
+uint64_t FileAccessUnix::get_64() const {
+	uint64_t res = 0;
+	get_buffer((uint8_t *)&res, sizeof(uint64_t));
+#ifdef BIG_ENDIAN_ENABLED
+	if (!big_endian) {
+		res = BSWAP64(res);
+	}
+#else
+	if (big_endian) {
+		res = BSWAP64(res);
+	}
+#endif
+	return res;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
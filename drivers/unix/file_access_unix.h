@@ -33,6 +33,9 @@
 
 #include "core/io/file_access.h"
 #include "core/os/memory.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/pair.h"
 
 #include <stdio.h>
 
@@ -49,11 +52,33 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Read-only sources (exported resources and packs) may be mapped into memory, reads are then served from the mapping
+	// without going through stdio.
+	// All accesses opened on the same file share one mapping (e.g. a PCK, which is opened once per packed file).
+	struct SharedMapping;
+	static Mutex mmap_mutex;
+	static HashMap<Pair<uint64_t, uint64_t>, SharedMapping *, PairHash<uint64_t, uint64_t>> shared_mappings; // By device and inode.
+	SharedMapping *shared_mapping = nullptr;
+	uint8_t *mapped = nullptr;
+	uint64_t mapped_length = 0;
+	mutable uint64_t mapped_pos = 0;
+
+	bool _is_read_only_source() const;
+	void _map(int p_fd);
+	void _unmap();
+
 	void _close();
 
 public:
 	static CloseNotificationFunc close_notification_func;
 
+	// Read-only sources opened for reading that are at least this big are memory-mapped, when enabled.
+	static const uint64_t MMAP_MIN_SIZE = 64 * 1024;
+	// Keep big files from exhausting the address space on 32-bit platforms.
+	static const uint64_t MMAP_MAX_SIZE_32_BITS = 256 * 1024 * 1024;
+	static void set_use_mmap(bool p_enable);
+	static bool is_using_mmap();
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
 
@@ -68,7 +93,11 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint8_t get_8() const override; ///< get a byte
+	virtual uint16_t get_16() const override;
+	virtual uint32_t get_32() const override;
+	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual uint64_t get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -89,6 +118,9 @@ public:
 
 	virtual void close() override;
 
+	bool is_mapped() const { return mapped != nullptr; }
+	static uint32_t get_shared_mapping_count();
+
 	FileAccessUnix() {}
 	virtual ~FileAccessUnix();
 };
@@ -44,6 +44,7 @@
 #include "editor/editor_paths.h"
 #include "editor/editor_resource_preview.h"
 #include "editor/editor_settings.h"
+#include "editor/import/editor_import_cache.h"
 
 EditorFileSystem *EditorFileSystem::singleton = nullptr;
 //the name is the version, to keep compatibility with different versions of Godot
@@ -326,10 +327,14 @@ void EditorFileSystem::_scan_filesystem() {
 	new_filesystem = memnew(EditorFileSystemDirectory);
 	new_filesystem->parent = nullptr;
 
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+
 	Ref<DirAccess> d = DirAccess::create(DirAccess::ACCESS_RESOURCES);
 	d->change_dir("res://");
 	_scan_new_dir(new_filesystem, d, sp);
 
+	print_verbose(vformat("EditorFileSystem: Scanned project in %d msec.", (OS::get_singleton()->get_ticks_usec() - start_usec) / 1000));
+
 	file_cache.clear(); //clear caches, no longer needed
 
 	if (!first_scan) {
@@ -562,6 +567,10 @@ bool EditorFileSystem::_scan_import_support(Vector<String> reimports) {
 	return false;
 }
 
+void EditorFileSystem::_test_for_reimport_thread(uint32_t p_index, ReimportTest *p_tests) {
+	p_tests[p_index].reimport = _test_for_reimport(p_tests[p_index].path, false);
+}
+
 bool EditorFileSystem::_update_scan_actions() {
 	sources_changed.clear();
 
@@ -570,6 +579,33 @@ bool EditorFileSystem::_update_scan_actions() {
 	Vector<String> reimports;
 	Vector<String> reloads;
 
+	// Testing for reimport hashes the source and imported files, so do it for all of them at once on the WorkerThreadPool.
+	// Looking up the importer of a file asks every importer for its name, so script-backed ones keep the tests on this thread.
+	bool script_importers = ResourceFormatImporter::get_singleton()->has_script_importers();
+	LocalVector<ReimportTest> reimport_tests;
+	for (const ItemAction &ia : scan_actions) {
+		if (ia.action == ItemAction::ACTION_FILE_TEST_REIMPORT) {
+			ReimportTest test;
+			test.path = ia.dir->get_path().path_join(ia.file);
+			reimport_tests.push_back(test);
+		}
+	}
+
+	if (reimport_tests.size()) {
+		uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		bool use_multiple_threads = GLOBAL_GET("editor/import/use_multiple_threads");
+		if (use_multiple_threads && !script_importers && reimport_tests.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_test_for_reimport_thread, reimport_tests.ptr(), reimport_tests.size(), -1, false, TTR("Test for reimport"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (ReimportTest &test : reimport_tests) {
+				test.reimport = _test_for_reimport(test.path, false);
+			}
+		}
+		print_verbose(vformat("EditorFileSystem: Tested %d files for reimport in %d msec.", reimport_tests.size(), (OS::get_singleton()->get_ticks_usec() - start_usec) / 1000));
+	}
+	uint32_t reimport_test_index = 0;
+
 	for (const ItemAction &ia : scan_actions) {
 		switch (ia.action) {
 			case ItemAction::ACTION_NONE: {
@@ -633,10 +669,11 @@ bool EditorFileSystem::_update_scan_actions() {
 
 			} break;
 			case ItemAction::ACTION_FILE_TEST_REIMPORT: {
+				const ReimportTest &test = reimport_tests[reimport_test_index++];
 				int idx = ia.dir->find_file_index(ia.file);
 				ERR_CONTINUE(idx == -1);
 				String full_path = ia.dir->get_file_path(idx);
-				if (_test_for_reimport(full_path, false)) {
+				if (test.reimport) {
 					//must reimport
 					reimports.push_back(full_path);
 					Vector<String> dependencies = _get_dependencies(full_path);
@@ -763,6 +800,12 @@ EditorFileSystem::ScanProgress EditorFileSystem::ScanProgress::get_sub(int p_cur
 }
 
 void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, const ScanProgress &p_progress) {
+	LocalVector<ScannedFile> scanned_files;
+	_scan_new_dir_tree(p_dir, da, p_progress.get_sub(0, 2), scanned_files);
+	_scan_files(scanned_files, p_progress.get_sub(1, 2));
+}
+
+void EditorFileSystem::_scan_new_dir_tree(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, const ScanProgress &p_progress, LocalVector<ScannedFile> &r_files) {
 	List<String> dirs;
 	List<String> files;
 
@@ -802,7 +845,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 	dirs.sort_custom<NaturalNoCaseComparator>();
 	files.sort_custom<NaturalNoCaseComparator>();
 
-	int total = dirs.size() + files.size();
+	int total = dirs.size();
 	int idx = 0;
 
 	for (List<String>::Element *E = dirs.front(); E; E = E->next(), idx++) {
@@ -817,7 +860,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 				efd->parent = p_dir;
 				efd->name = E->get();
 
-				_scan_new_dir(efd, da, p_progress.get_sub(idx, total));
+				_scan_new_dir_tree(efd, da, p_progress.get_sub(idx, total), r_files);
 
 				int idx2 = 0;
 				for (int i = 0; i < p_dir->subdirs.size(); i++) {
@@ -841,120 +884,184 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 		p_progress.update(idx, total);
 	}
 
-	for (List<String>::Element *E = files.front(); E; E = E->next(), idx++) {
-		String ext = E->get().get_extension().to_lower();
+	// The files themselves are inspected later by _scan_files(), so it can be done for the whole tree at once.
+	for (const String &file : files) {
+		String ext = file.get_extension().to_lower();
 		if (!valid_extensions.has(ext)) {
 			continue; //invalid
 		}
 
-		EditorFileSystemDirectory::FileInfo *fi = memnew(EditorFileSystemDirectory::FileInfo);
-		fi->file = E->get();
+		ScannedFile sf;
+		sf.dir = p_dir;
+		sf.fi = memnew(EditorFileSystemDirectory::FileInfo);
+		sf.fi->file = file;
+		sf.path = cd.path_join(file);
+		r_files.push_back(sf);
+	}
+}
+
+void EditorFileSystem::_scan_file_thread(uint32_t p_index, ScannedFile *p_files) {
+	if (p_files[p_index].serial) {
+		return; // Scanned afterwards, on the calling thread.
+	}
+	_scan_file(p_files[p_index]);
+}
+
+void EditorFileSystem::_scan_file(ScannedFile &p_file) {
+	// May run on the WorkerThreadPool, must not modify anything but the scanned file.
+	EditorFileSystemDirectory::FileInfo *fi = p_file.fi;
+	const String &path = p_file.path;
+	String ext = fi->file.get_extension().to_lower();
 
-		String path = cd.path_join(fi->file);
+	const FileCache *fc = file_cache.getptr(path);
+	uint64_t mt = FileAccess::get_modified_time(path);
 
-		FileCache *fc = file_cache.getptr(path);
-		uint64_t mt = FileAccess::get_modified_time(path);
+	if (import_extensions.has(ext)) {
+		//is imported
+		uint64_t import_mt = 0;
+		if (FileAccess::exists(path + ".import")) {
+			import_mt = FileAccess::get_modified_time(path + ".import");
+		}
+
+		if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
+			fi->type = fc->type;
+			fi->resource_script_class = fc->resource_script_class;
+			fi->uid = fc->uid;
+			fi->deps = fc->deps;
+			fi->modified_time = fc->modification_time;
+			fi->import_modified_time = fc->import_modification_time;
+
+			fi->import_valid = fc->import_valid;
+			fi->script_class_name = fc->script_class_name;
+			fi->import_group_file = fc->import_group_file;
+			fi->script_class_extends = fc->script_class_extends;
+			fi->script_class_icon_path = fc->script_class_icon_path;
 
-		if (import_extensions.has(ext)) {
-			//is imported
-			uint64_t import_mt = 0;
-			if (FileAccess::exists(path + ".import")) {
-				import_mt = FileAccess::get_modified_time(path + ".import");
+			if (revalidate_import_files && !ResourceFormatImporter::get_singleton()->are_import_settings_valid(path)) {
+				p_file.test_reimport = true;
 			}
 
-			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
-				fi->type = fc->type;
-				fi->resource_script_class = fc->resource_script_class;
-				fi->uid = fc->uid;
-				fi->deps = fc->deps;
-				fi->modified_time = fc->modification_time;
-				fi->import_modified_time = fc->import_modification_time;
+			if (fc->type.is_empty()) {
+				fi->type = ResourceLoader::get_resource_type(path);
+				fi->resource_script_class = ResourceLoader::get_resource_script_class(path);
+				fi->import_group_file = ResourceLoader::get_import_group_file(path);
+				//there is also the chance that file type changed due to reimport, must probably check this somehow here (or kind of note it for next time in another file?)
+				//note: I think this should not happen any longer..
+			}
 
-				fi->import_valid = fc->import_valid;
-				fi->script_class_name = fc->script_class_name;
-				fi->import_group_file = fc->import_group_file;
-				fi->script_class_extends = fc->script_class_extends;
-				fi->script_class_icon_path = fc->script_class_icon_path;
+			if (fc->uid == ResourceUID::INVALID_ID) {
+				// imported files should always have a UID, so attempt to fetch it.
+				fi->uid = ResourceLoader::get_resource_uid(path);
+			}
 
-				if (revalidate_import_files && !ResourceFormatImporter::get_singleton()->are_import_settings_valid(path)) {
-					ItemAction ia;
-					ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-					ia.dir = p_dir;
-					ia.file = E->get();
-					scan_actions.push_back(ia);
-				}
+		} else {
+			fi->type = ResourceFormatImporter::get_singleton()->get_resource_type(path);
+			fi->uid = ResourceFormatImporter::get_singleton()->get_resource_uid(path);
+			fi->import_group_file = ResourceFormatImporter::get_singleton()->get_import_group_file(path);
+			fi->modified_time = 0;
+			fi->import_modified_time = 0;
+			fi->import_valid = fi->type == "TextFile" ? true : ResourceLoader::is_import_valid(path);
 
-				if (fc->type.is_empty()) {
-					fi->type = ResourceLoader::get_resource_type(path);
-					fi->resource_script_class = ResourceLoader::get_resource_script_class(path);
-					fi->import_group_file = ResourceLoader::get_import_group_file(path);
-					//there is also the chance that file type changed due to reimport, must probably check this somehow here (or kind of note it for next time in another file?)
-					//note: I think this should not happen any longer..
-				}
+			p_file.update_global_class = true;
+			p_file.test_reimport = true;
+		}
+	} else {
+		if (fc && fc->modification_time == mt) {
+			//not imported, so just update type if changed
+			fi->type = fc->type;
+			fi->resource_script_class = fc->resource_script_class;
+			fi->uid = fc->uid;
+			fi->modified_time = fc->modification_time;
+			fi->deps = fc->deps;
+			fi->import_modified_time = 0;
+			fi->import_valid = true;
+			fi->script_class_name = fc->script_class_name;
+			fi->script_class_extends = fc->script_class_extends;
+			fi->script_class_icon_path = fc->script_class_icon_path;
+		} else {
+			//new or modified time
+			fi->type = ResourceLoader::get_resource_type(path);
+			fi->resource_script_class = ResourceLoader::get_resource_script_class(path);
+			if (fi->type == "" && textfile_extensions.has(ext)) {
+				fi->type = "TextFile";
+			}
+			fi->uid = ResourceLoader::get_resource_uid(path);
+			fi->deps = _get_dependencies(path);
+			fi->modified_time = mt;
+			fi->import_modified_time = 0;
+			fi->import_valid = true;
 
-				if (fc->uid == ResourceUID::INVALID_ID) {
-					// imported files should always have a UID, so attempt to fetch it.
-					fi->uid = ResourceLoader::get_resource_uid(path);
+			p_file.update_global_class = true;
+			p_file.update_script_class = ClassDB::is_parent_class(fi->type, SNAME("Script"));
+		}
+	}
+}
+
+void EditorFileSystem::_scan_files(LocalVector<ScannedFile> &p_files, const ScanProgress &p_progress) {
+	// Inspecting a file means reading its .import and .md5 files, so it's done in batches on the WorkerThreadPool.
+	// Everything that touches shared state is applied afterwards, in order, on this thread.
+	const uint32_t batch_size = 256;
+	bool use_multiple_threads = GLOBAL_GET("editor/import/use_multiple_threads");
+
+	// Script languages don't promise to be thread-safe, so files whose inspection may run scripts are scanned on this thread.
+	// Type and UID lookups fall through to every registered loader, and imported files are also checked by their importer.
+	bool script_loaders = ResourceLoader::has_script_loaders();
+	bool script_importers = ResourceFormatImporter::get_singleton()->has_script_importers();
+	for (ScannedFile &sf : p_files) {
+		sf.serial = script_loaders || (script_importers && import_extensions.has(sf.fi->file.get_extension().to_lower()));
+	}
+
+	for (uint32_t from = 0; from < p_files.size(); from += batch_size) {
+		uint32_t count = MIN(batch_size, p_files.size() - from);
+		ScannedFile *batch = p_files.ptr() + from;
+
+		if (use_multiple_threads && !script_loaders && count > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_scan_file_thread, batch, count, -1, false, TTR("Scan project files"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			for (uint32_t i = 0; i < count; i++) {
+				if (batch[i].serial) {
+					_scan_file(batch[i]);
 				}
+			}
+		} else {
+			for (uint32_t i = 0; i < count; i++) {
+				_scan_file(batch[i]);
+			}
+		}
 
-			} else {
-				fi->type = ResourceFormatImporter::get_singleton()->get_resource_type(path);
-				fi->uid = ResourceFormatImporter::get_singleton()->get_resource_uid(path);
-				fi->import_group_file = ResourceFormatImporter::get_singleton()->get_import_group_file(path);
-				fi->script_class_name = _get_global_script_class(fi->type, path, &fi->script_class_extends, &fi->script_class_icon_path);
-				fi->modified_time = 0;
-				fi->import_modified_time = 0;
-				fi->import_valid = fi->type == "TextFile" ? true : ResourceLoader::is_import_valid(path);
+		for (uint32_t i = 0; i < count; i++) {
+			ScannedFile &sf = batch[i];
+			EditorFileSystemDirectory::FileInfo *fi = sf.fi;
+
+			if (sf.update_global_class) {
+				// Script languages don't promise to be thread-safe, so this stays out of _scan_file().
+				fi->script_class_name = _get_global_script_class(fi->type, sf.path, &fi->script_class_extends, &fi->script_class_icon_path);
+			}
 
+			if (sf.test_reimport) {
 				ItemAction ia;
 				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-				ia.dir = p_dir;
-				ia.file = E->get();
+				ia.dir = sf.dir;
+				ia.file = fi->file;
 				scan_actions.push_back(ia);
 			}
-		} else {
-			if (fc && fc->modification_time == mt) {
-				//not imported, so just update type if changed
-				fi->type = fc->type;
-				fi->resource_script_class = fc->resource_script_class;
-				fi->uid = fc->uid;
-				fi->modified_time = fc->modification_time;
-				fi->deps = fc->deps;
-				fi->import_modified_time = 0;
-				fi->import_valid = true;
-				fi->script_class_name = fc->script_class_name;
-				fi->script_class_extends = fc->script_class_extends;
-				fi->script_class_icon_path = fc->script_class_icon_path;
-			} else {
-				//new or modified time
-				fi->type = ResourceLoader::get_resource_type(path);
-				fi->resource_script_class = ResourceLoader::get_resource_script_class(path);
-				if (fi->type == "" && textfile_extensions.has(ext)) {
-					fi->type = "TextFile";
-				}
-				fi->uid = ResourceLoader::get_resource_uid(path);
-				fi->script_class_name = _get_global_script_class(fi->type, path, &fi->script_class_extends, &fi->script_class_icon_path);
-				fi->deps = _get_dependencies(path);
-				fi->modified_time = mt;
-				fi->import_modified_time = 0;
-				fi->import_valid = true;
-
-				if (ClassDB::is_parent_class(fi->type, SNAME("Script"))) {
-					_queue_update_script_class(path);
-				}
+
+			if (sf.update_script_class) {
+				_queue_update_script_class(sf.path);
 			}
-		}
 
-		if (fi->uid != ResourceUID::INVALID_ID) {
-			if (ResourceUID::get_singleton()->has_id(fi->uid)) {
-				ResourceUID::get_singleton()->set_id(fi->uid, path);
-			} else {
-				ResourceUID::get_singleton()->add_id(fi->uid, path);
+			if (fi->uid != ResourceUID::INVALID_ID) {
+				if (ResourceUID::get_singleton()->has_id(fi->uid)) {
+					ResourceUID::get_singleton()->set_id(fi->uid, sf.path);
+				} else {
+					ResourceUID::get_singleton()->add_id(fi->uid, sf.path);
+				}
 			}
+
+			sf.dir->files.push_back(fi);
 		}
 
-		p_dir->files.push_back(fi);
-		p_progress.update(idx, total);
+		p_progress.update(from + count, p_files.size());
 	}
 }
 
@@ -2045,7 +2152,32 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant meta;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+	Error err;
+
+	String cache_key;
+	String cache_path = EDITOR_GET("filesystem/import/cache_path");
+	if (!cache_path.is_empty() && fs->files[cpos]->import_group_file.is_empty()) {
+		cache_key = EditorImportCache::get_key(p_file, importer, opts, params);
+	}
+
+	if (!cache_key.is_empty() && EditorImportCache::fetch(cache_path, cache_key, base_path, &import_variants, &meta)) {
+		import_cache_hits.increment();
+		err = OK;
+	} else {
+		err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+
+		if (!cache_key.is_empty()) {
+			import_cache_misses.increment();
+			// Generated files live outside of the imported folder and are usually meant to be edited, so don't share them.
+			// Editor variants of textures depend on the editor's scale and theme, and aren't among the reported files.
+			bool editor_variant = meta.get_type() == Variant::DICTIONARY && Dictionary(meta).has("has_editor_variant");
+			if (err == OK && gen_files.is_empty() && !editor_variant) {
+				if (EditorImportCache::store(cache_path, cache_key, base_path, importer->get_save_extension(), import_variants, meta)) {
+					import_cache_stores.increment();
+				}
+			}
+		}
+	}
 
 	ERR_FAIL_COND_V_MSG(err != OK, ERR_FILE_UNRECOGNIZED, "Error importing '" + p_file + "'.");
 
@@ -2223,6 +2355,10 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	EditorProgress pr("reimport", TTR("(Re)Importing Assets"), p_files.size());
 
+	import_cache_hits.set(0);
+	import_cache_misses.set(0);
+	import_cache_stores.set(0);
+
 	Vector<ImportFile> reimport_files;
 
 	HashSet<String> groups_to_reimport;
@@ -2338,6 +2474,12 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	_save_filesystem_cache();
 	_update_pending_script_classes();
+
+	if (import_cache_hits.get() || import_cache_misses.get()) {
+		uint32_t lookups = import_cache_hits.get() + import_cache_misses.get();
+		print_verbose(vformat("EditorFileSystem: Import cache: %d hits out of %d lookups (%d%%), %d new entries stored.", import_cache_hits.get(), lookups, import_cache_hits.get() * 100 / lookups, import_cache_stores.get()));
+	}
+
 	importing = false;
 	if (!is_scanning()) {
 		emit_signal(SNAME("filesystem_changed"));
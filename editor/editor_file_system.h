@@ -35,6 +35,7 @@
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
@@ -227,7 +228,21 @@ class EditorFileSystem : public Node {
 	HashSet<String> valid_extensions;
 	HashSet<String> import_extensions;
 
+	struct ScannedFile {
+		EditorFileSystemDirectory *dir = nullptr;
+		EditorFileSystemDirectory::FileInfo *fi = nullptr;
+		String path;
+		bool test_reimport = false;
+		bool update_global_class = false;
+		bool update_script_class = false;
+		bool serial = false;
+	};
+
 	void _scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, const ScanProgress &p_progress);
+	void _scan_new_dir_tree(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, const ScanProgress &p_progress, LocalVector<ScannedFile> &r_files);
+	void _scan_file(ScannedFile &p_file);
+	void _scan_file_thread(uint32_t p_index, ScannedFile *p_files);
+	void _scan_files(LocalVector<ScannedFile> &p_files, const ScanProgress &p_progress);
 
 	Thread thread_sources;
 	bool scanning_changes = false;
@@ -242,11 +257,22 @@ class EditorFileSystem : public Node {
 
 	void _update_extensions();
 
+	SafeNumeric<uint32_t> import_cache_hits;
+	SafeNumeric<uint32_t> import_cache_misses;
+	SafeNumeric<uint32_t> import_cache_stores;
+
 	Error _reimport_file(const String &p_file, const HashMap<StringName, Variant> &p_custom_options = HashMap<StringName, Variant>(), const String &p_custom_importer = String(), Variant *generator_parameters = nullptr);
 	Error _reimport_group(const String &p_group_file, const Vector<String> &p_files);
 
 	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
 
+	struct ReimportTest {
+		String path;
+		bool reimport = false;
+	};
+
+	void _test_for_reimport_thread(uint32_t p_index, ReimportTest *p_tests);
+
 	bool reimport_on_missing_imported_files;
 
 	Vector<String> _get_dependencies(const String &p_path);
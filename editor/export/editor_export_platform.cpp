@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
 #include "core/extension/gdextension.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/io/zip_io.h"
@@ -60,6 +61,10 @@ static int _get_pad(int p_alignment, int p_n) {
 }
 
 #define PCK_PADDING 16
+// Small enough that a seek in a compressed file only has to decompress a little data.
+#define PCK_COMPRESSION_BLOCK_SIZE (64 * 1024)
+// Smaller files are read whole anyway and barely shrink.
+#define PCK_COMPRESSION_MIN_SIZE 1024
 
 bool EditorExportPlatform::fill_log_messages(RichTextLabel *p_log, Error p_err) {
 	bool has_messages = false;
@@ -256,8 +261,22 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		ftmp = fae;
 	}
 
+	Vector<uint8_t> compressed_data;
+	if (pd->compress && p_data.size() >= PCK_COMPRESSION_MIN_SIZE && (uint64_t)p_data.size() <= UINT32_MAX) {
+		compressed_data = FileAccessCompressed::compress_blocks(p_data.ptr(), p_data.size(), PACK_FILE_COMPRESSED_MAGIC, pd->compression_mode, PCK_COMPRESSION_BLOCK_SIZE);
+		// Already compressed data (e.g. textures, audio) is stored as is, it wouldn't be worth decompressing it on load.
+		if (compressed_data.size() > p_data.size() - p_data.size() / 8) {
+			compressed_data.clear();
+		}
+	}
+	sd.compressed = !compressed_data.is_empty();
+
 	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	if (sd.compressed) {
+		ftmp->store_buffer(compressed_data.ptr(), compressed_data.size());
+	} else {
+		ftmp->store_buffer(p_data.ptr(), p_data.size());
+	}
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -1548,6 +1567,10 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
 
+	int pck_compression = GLOBAL_GET("editor/export/pck_compression");
+	pd.compress = pck_compression != 0;
+	pd.compression_mode = pck_compression == 1 ? Compression::MODE_FASTLZ : Compression::MODE_ZSTD;
+
 	Error err = export_project_files(p_preset, p_debug, _save_pack_file, &pd, _add_shared_object);
 
 	// Close temp file.
@@ -1597,8 +1620,17 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	int64_t pck_start_pos = f->get_position();
 
+	// Packs without compressed files keep the previous version, so older engines can still load them.
+	uint32_t pack_version = PACK_FORMAT_VERSION_NO_COMPRESSION;
+	for (int i = 0; i < pd.file_ofs.size(); i++) {
+		if (pd.file_ofs[i].compressed) {
+			pack_version = PACK_FORMAT_VERSION;
+			break;
+		}
+	}
+
 	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
+	f->store_32(pack_version);
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(VERSION_PATCH);
@@ -1685,6 +1717,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
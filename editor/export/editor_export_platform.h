@@ -74,6 +74,7 @@ private:
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
 
@@ -87,6 +88,8 @@ private:
 		Vector<SavedData> file_ofs;
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
+		bool compress = false;
+		Compression::Mode compression_mode = Compression::MODE_ZSTD;
 	};
 
 	struct ZipData {
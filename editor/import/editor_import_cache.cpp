@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  editor_import_cache.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "editor_import_cache.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/config_file.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/variant/variant_parser.h"
+#include "core/version.h"
+
+String EditorImportCache::get_key(const String &p_file, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params) {
+	String source_hash = FileAccess::get_sha256(p_file);
+	if (source_hash.is_empty()) {
+		return String();
+	}
+
+	// The path is part of the key, as the imported files are named after it and may refer to files next to it.
+	String key = String(VERSION_FULL_BUILD) + "\n" + p_file + "\n" + source_hash + "\n" + p_importer->get_importer_name() + "\n" + itos(p_importer->get_format_version()) + "\n";
+	for (const ResourceImporter::ImportOption &E : p_options) {
+		String value;
+		VariantWriter::write_to_string(p_params.has(E.option.name) ? p_params[E.option.name] : Variant(), value);
+		key += String(E.option.name) + "=" + value + "\n";
+	}
+
+	return key.sha256_text();
+}
+
+bool EditorImportCache::fetch(const String &p_cache_path, const String &p_key, const String &p_base_path, List<String> *r_variants, Variant *r_metadata) {
+	String entry_path = ProjectSettings::get_singleton()->globalize_path(p_cache_path).path_join(p_key.substr(0, 2)).path_join(p_key);
+
+	Ref<ConfigFile> manifest;
+	manifest.instantiate();
+	if (manifest->load(entry_path.path_join("manifest.cfg")) != OK) {
+		return false;
+	}
+
+	String base_path = ProjectSettings::get_singleton()->globalize_path(p_base_path);
+	PackedStringArray files = manifest->get_value("entry", "files", PackedStringArray());
+	for (const String &file : files) {
+		if (DirAccess::copy_absolute(entry_path.path_join(file), base_path + file.trim_prefix("base")) != OK) {
+			return false;
+		}
+	}
+
+	PackedStringArray variants = manifest->get_value("entry", "variants", PackedStringArray());
+	for (const String &variant : variants) {
+		r_variants->push_back(variant);
+	}
+	*r_metadata = manifest->get_value("entry", "metadata", Variant());
+	return true;
+}
+
+bool EditorImportCache::store(const String &p_cache_path, const String &p_key, const String &p_base_path, const String &p_save_extension, const List<String> &p_variants, const Variant &p_metadata) {
+	String bucket_path = ProjectSettings::get_singleton()->globalize_path(p_cache_path).path_join(p_key.substr(0, 2));
+	String entry_path = bucket_path.path_join(p_key);
+	if (DirAccess::dir_exists_absolute(entry_path)) {
+		return false;
+	}
+
+	// The files the importer reported, named the same way as the paths in the .import file.
+	// They're stored under a fixed name, as the base path itself depends on where the project is.
+	PackedStringArray files;
+	if (!p_save_extension.is_empty()) {
+		if (p_variants.size()) {
+			for (const String &variant : p_variants) {
+				files.push_back("base." + variant + "." + p_save_extension);
+			}
+		} else {
+			files.push_back("base." + p_save_extension);
+		}
+	}
+
+	// Written to a temporary folder and renamed, so other editors sharing the cache never see partial entries.
+	String temp_path = bucket_path.path_join(p_key + "-" + itos(OS::get_singleton()->get_process_id()) + "-" + itos(Thread::get_caller_id()) + ".tmp");
+	ERR_FAIL_COND_V_MSG(DirAccess::make_dir_recursive_absolute(temp_path) != OK, false, "Cannot create import cache folder '" + temp_path + "'.");
+
+	String base_path = ProjectSettings::get_singleton()->globalize_path(p_base_path);
+	bool copied = true;
+	for (const String &file : files) {
+		if (DirAccess::copy_absolute(base_path + file.trim_prefix("base"), temp_path.path_join(file)) != OK) {
+			copied = false;
+			break;
+		}
+	}
+
+	if (copied) {
+		Ref<ConfigFile> manifest;
+		manifest.instantiate();
+		PackedStringArray variants;
+		for (const String &variant : p_variants) {
+			variants.push_back(variant);
+		}
+		manifest->set_value("entry", "files", files);
+		manifest->set_value("entry", "variants", variants);
+		manifest->set_value("entry", "metadata", p_metadata);
+		copied = manifest->save(temp_path.path_join("manifest.cfg")) == OK;
+	}
+
+	if (copied && DirAccess::rename_absolute(temp_path, entry_path) == OK) {
+		return true;
+	}
+
+	// Another editor stored it first, or the cache isn't writable.
+	Ref<DirAccess> da = DirAccess::open(temp_path);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+	}
+	DirAccess::remove_absolute(temp_path);
+	return false;
+}
@@ -30,9 +30,12 @@
 
 #include "resource_importer_scene.h"
 
+#include "core/config/project_settings.h"
 #include "core/error/error_macros.h"
+#include "core/io/dir_access.h"
 #include "core/io/resource_saver.h"
 #include "core/object/script_language.h"
+#include "core/version.h"
 #include "editor/editor_node.h"
 #include "editor/editor_settings.h"
 #include "editor/import/scene_import_settings.h"
@@ -1708,6 +1711,8 @@ void ResourceImporterScene::get_internal_import_options(InternalImportCategory p
 			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "generate/lods", PROPERTY_HINT_ENUM, "Default,Enable,Disable"), 0));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "lods/normal_split_angle", PROPERTY_HINT_RANGE, "0,180,0.1,degrees"), 25.0f));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "lods/normal_merge_angle", PROPERTY_HINT_RANGE, "0,180,0.1,degrees"), 60.0f));
+			r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "clusters/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), false));
+			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "clusters/max_triangles", PROPERTY_HINT_RANGE, "1024,1048576,1,or_greater"), 16384));
 		} break;
 		case INTERNAL_IMPORT_CATEGORY_MATERIAL: {
 			r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "use_external/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), false));
@@ -1831,6 +1836,9 @@ bool ResourceImporterScene::get_internal_option_visibility(InternalImportCategor
 			if (p_option == "save_to_file/path" || p_option == "save_to_file/make_streamable") {
 				return p_options["save_to_file/enabled"];
 			}
+			if (p_option == "clusters/max_triangles") {
+				return p_options["clusters/enabled"];
+			}
 		} break;
 		case INTERNAL_IMPORT_CATEGORY_MATERIAL: {
 			if (p_option == "use_external/path") {
@@ -2006,11 +2014,12 @@ Array ResourceImporterScene::_get_skinned_pose_transforms(ImporterMeshInstance3D
 	return skin_pose_transform_array;
 }
 
-Node *ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_mesh_data, bool p_generate_lods, bool p_create_shadow_meshes, LightBakeMode p_light_bake_mode, float p_lightmap_texel_size, const Vector<uint8_t> &p_src_lightmap_cache, Vector<Vector<uint8_t>> &r_lightmap_caches) {
+Node *ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_mesh_data, bool p_generate_lods, bool p_create_shadow_meshes, LightBakeMode p_light_bake_mode, float p_lightmap_texel_size, const Vector<uint8_t> &p_src_lightmap_cache, Vector<Vector<uint8_t>> &r_lightmap_caches, const Dictionary &p_src_lod_cache, Dictionary &r_lod_caches) {
 	ImporterMeshInstance3D *src_mesh_node = Object::cast_to<ImporterMeshInstance3D>(p_node);
 	if (src_mesh_node) {
 		//is mesh
 		MeshInstance3D *mesh_node = memnew(MeshInstance3D);
+		Vector<MeshInstance3D *> cluster_nodes;
 		mesh_node->set_name(src_mesh_node->get_name());
 		mesh_node->set_transform(src_mesh_node->get_transform());
 		mesh_node->set_skin(src_mesh_node->get_skin());
@@ -2025,6 +2034,8 @@ Node *ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_
 				float merge_angle = 60.0f;
 				bool create_shadow_meshes = p_create_shadow_meshes;
 				bool bake_lightmaps = p_light_bake_mode == LIGHT_BAKE_STATIC_LIGHTMAPS;
+				bool split_clusters = false;
+				int cluster_max_triangles = 16384;
 				String save_to_file;
 
 				String mesh_id = src_mesh_node->get_mesh()->get_meta("import_id", src_mesh_node->get_mesh()->get_name());
@@ -2077,6 +2088,14 @@ Node *ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_
 						merge_angle = mesh_settings["lods/normal_merge_angle"];
 					}
 
+					if (mesh_settings.has("clusters/enabled")) {
+						split_clusters = mesh_settings["clusters/enabled"];
+					}
+
+					if (mesh_settings.has("clusters/max_triangles")) {
+						cluster_max_triangles = mesh_settings["clusters/max_triangles"];
+					}
+
 					if (mesh_settings.has("save_to_file/enabled") && bool(mesh_settings["save_to_file/enabled"]) && mesh_settings.has("save_to_file/path")) {
 						save_to_file = mesh_settings["save_to_file/path"];
 						if (!save_to_file.is_resource_file()) {
@@ -2121,15 +2140,43 @@ Node *ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_
 					}
 				}
 
+				// Splitting happens after unwrapping, so it is skipped when baking lightmaps: every part would
+				// get its own lightmap with the size of the whole mesh.
+				Vector<Ref<ImporterMesh>> cluster_meshes;
+				if (split_clusters && !bake_lightmaps && save_to_file.is_empty() && src_mesh_node->get_skin().is_null()) {
+					bool has_surface_overrides = false;
+					for (int i = 0; i < src_mesh_node->get_mesh()->get_surface_count(); i++) {
+						if (src_mesh_node->get_surface_material(i).is_valid()) {
+							has_surface_overrides = true;
+							break;
+						}
+					}
+					if (!has_surface_overrides) {
+						cluster_meshes = src_mesh_node->get_mesh()->split_into_clusters(cluster_max_triangles);
+					}
+				}
+
+				Array skin_pose_transform_array;
 				if (generate_lods) {
-					Array skin_pose_transform_array = _get_skinned_pose_transforms(src_mesh_node);
-					src_mesh_node->get_mesh()->generate_lods(merge_angle, split_angle, skin_pose_transform_array);
+					skin_pose_transform_array = _get_skinned_pose_transforms(src_mesh_node);
 				}
 
-				if (create_shadow_meshes) {
-					src_mesh_node->get_mesh()->create_shadow_mesh();
+				if (!cluster_meshes.is_empty()) {
+					// The first part keeps the node, the others become children of it.
+					src_mesh_node->set_mesh(cluster_meshes[0]);
+					for (int i = 1; i < cluster_meshes.size(); i++) {
+						_generate_lods_and_shadow_mesh(cluster_meshes[i], generate_lods, create_shadow_meshes, merge_angle, split_angle, skin_pose_transform_array, p_src_lod_cache, r_lod_caches);
+
+						MeshInstance3D *cluster_node = memnew(MeshInstance3D);
+						cluster_node->set_name("Cluster" + itos(i));
+						cluster_node->set_mesh(cluster_meshes[i]->get_mesh());
+						mesh_node->add_child(cluster_node, true);
+						cluster_nodes.push_back(cluster_node);
+					}
 				}
 
+				_generate_lods_and_shadow_mesh(src_mesh_node->get_mesh(), generate_lods, create_shadow_meshes, merge_angle, split_angle, skin_pose_transform_array, p_src_lod_cache, r_lod_caches);
+
 				if (!save_to_file.is_empty()) {
 					Ref<Mesh> existing = ResourceCache::get_ref(save_to_file);
 					if (existing.is_valid()) {
@@ -2157,40 +2204,75 @@ Node *ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_
 			}
 		}
 
-		switch (p_light_bake_mode) {
-			case LIGHT_BAKE_DISABLED: {
-				mesh_node->set_gi_mode(GeometryInstance3D::GI_MODE_DISABLED);
-			} break;
-			case LIGHT_BAKE_DYNAMIC: {
-				mesh_node->set_gi_mode(GeometryInstance3D::GI_MODE_DYNAMIC);
-			} break;
-			case LIGHT_BAKE_STATIC:
-			case LIGHT_BAKE_STATIC_LIGHTMAPS: {
-				mesh_node->set_gi_mode(GeometryInstance3D::GI_MODE_STATIC);
-			} break;
-		}
+		cluster_nodes.insert(0, mesh_node);
+		for (MeshInstance3D *node : cluster_nodes) {
+			switch (p_light_bake_mode) {
+				case LIGHT_BAKE_DISABLED: {
+					node->set_gi_mode(GeometryInstance3D::GI_MODE_DISABLED);
+				} break;
+				case LIGHT_BAKE_DYNAMIC: {
+					node->set_gi_mode(GeometryInstance3D::GI_MODE_DYNAMIC);
+				} break;
+				case LIGHT_BAKE_STATIC:
+				case LIGHT_BAKE_STATIC_LIGHTMAPS: {
+					node->set_gi_mode(GeometryInstance3D::GI_MODE_STATIC);
+				} break;
+			}
 
-		mesh_node->set_layer_mask(src_mesh_node->get_layer_mask());
-		mesh_node->set_cast_shadows_setting(src_mesh_node->get_cast_shadows_setting());
-		mesh_node->set_visibility_range_begin(src_mesh_node->get_visibility_range_begin());
-		mesh_node->set_visibility_range_begin_margin(src_mesh_node->get_visibility_range_begin_margin());
-		mesh_node->set_visibility_range_end(src_mesh_node->get_visibility_range_end());
-		mesh_node->set_visibility_range_end_margin(src_mesh_node->get_visibility_range_end_margin());
-		mesh_node->set_visibility_range_fade_mode(src_mesh_node->get_visibility_range_fade_mode());
+			node->set_layer_mask(src_mesh_node->get_layer_mask());
+			node->set_cast_shadows_setting(src_mesh_node->get_cast_shadows_setting());
+			node->set_visibility_range_begin(src_mesh_node->get_visibility_range_begin());
+			node->set_visibility_range_begin_margin(src_mesh_node->get_visibility_range_begin_margin());
+			node->set_visibility_range_end(src_mesh_node->get_visibility_range_end());
+			node->set_visibility_range_end_margin(src_mesh_node->get_visibility_range_end_margin());
+			node->set_visibility_range_fade_mode(src_mesh_node->get_visibility_range_fade_mode());
+		}
 
 		p_node->replace_by(mesh_node);
 		p_node->set_owner(nullptr);
 		memdelete(p_node);
 		p_node = mesh_node;
+
+		for (int i = 1; i < cluster_nodes.size(); i++) {
+			cluster_nodes[i]->set_owner(mesh_node->get_owner());
+		}
 	}
 
 	for (int i = 0; i < p_node->get_child_count(); i++) {
-		_generate_meshes(p_node->get_child(i), p_mesh_data, p_generate_lods, p_create_shadow_meshes, p_light_bake_mode, p_lightmap_texel_size, p_src_lightmap_cache, r_lightmap_caches);
+		_generate_meshes(p_node->get_child(i), p_mesh_data, p_generate_lods, p_create_shadow_meshes, p_light_bake_mode, p_lightmap_texel_size, p_src_lightmap_cache, r_lightmap_caches, p_src_lod_cache, r_lod_caches);
 	}
 
 	return p_node;
 }
 
+void ResourceImporterScene::_generate_lods_and_shadow_mesh(const Ref<ImporterMesh> &p_mesh, bool p_generate_lods, bool p_create_shadow_mesh, float p_merge_angle, float p_split_angle, const Array &p_skin_pose_transform_array, const Dictionary &p_src_lod_cache, Dictionary &r_lod_caches) {
+	if (!p_generate_lods && !p_create_shadow_mesh) {
+		return;
+	}
+
+	// The key covers the engine build and cache layout (the cache survives upgrades, and the simplifier may change between them),
+	// the mesh as it is right before generation (after unwrapping) and every setting that affects the result.
+	Array lod_settings;
+	lod_settings.push_back(p_generate_lods);
+	lod_settings.push_back(p_create_shadow_mesh);
+	lod_settings.push_back(p_merge_angle);
+	lod_settings.push_back(p_split_angle);
+	lod_settings.push_back(p_skin_pose_transform_array);
+	String lod_cache_key = String(VERSION_FULL_BUILD) + "-" + itos(ImporterMesh::LOD_CACHE_FORMAT_VERSION) + "-" + p_mesh->get_content_hash() + "-" + String::num_uint64(lod_settings.hash(), 16);
+
+	if (!p_src_lod_cache.has(lod_cache_key) || !p_mesh->set_lod_cache_data(p_src_lod_cache[lod_cache_key])) {
+		if (p_generate_lods) {
+			p_mesh->generate_lods(p_merge_angle, p_split_angle, p_skin_pose_transform_array);
+		}
+
+		if (p_create_shadow_mesh) {
+			p_mesh->create_shadow_mesh();
+		}
+	}
+
+	r_lod_caches[lod_cache_key] = p_mesh->get_lod_cache_data();
+}
+
 void ResourceImporterScene::_add_shapes(Node *p_node, const Vector<Ref<Shape3D>> &p_shapes) {
 	for (const Ref<Shape3D> &E : p_shapes) {
 		CollisionShape3D *cshape = memnew(CollisionShape3D);
@@ -2564,11 +2646,32 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		}
 	}
 
+	// LODs and shadow meshes of unchanged meshes are reused from the previous import.
+	String lod_cache_path = ProjectSettings::get_singleton()->get_imported_files_path().path_join(p_source_file.get_file() + "-" + p_source_file.md5_text() + ".lod_cache");
+	Dictionary src_lod_cache;
+	Dictionary mesh_lod_caches;
+
+	{
+		Ref<FileAccess> f = FileAccess::open(lod_cache_path, FileAccess::READ);
+		if (f.is_valid()) {
+			src_lod_cache = f->get_var();
+		}
+	}
+
 	Dictionary mesh_data;
 	if (subresources.has("meshes")) {
 		mesh_data = subresources["meshes"];
 	}
-	scene = _generate_meshes(scene, mesh_data, gen_lods, create_shadow_meshes, LightBakeMode(light_bake_mode), lightmap_texel_size, src_lightmap_cache, mesh_lightmap_caches);
+	scene = _generate_meshes(scene, mesh_data, gen_lods, create_shadow_meshes, LightBakeMode(light_bake_mode), lightmap_texel_size, src_lightmap_cache, mesh_lightmap_caches, src_lod_cache, mesh_lod_caches);
+
+	if (mesh_lod_caches.size()) {
+		Ref<FileAccess> f = FileAccess::open(lod_cache_path, FileAccess::WRITE);
+		if (f.is_valid()) {
+			f->store_var(mesh_lod_caches);
+		}
+	} else if (FileAccess::exists(lod_cache_path)) {
+		DirAccess::remove_absolute(lod_cache_path);
+	}
 
 	if (mesh_lightmap_caches.size()) {
 		Ref<FileAccess> f = FileAccess::open(p_source_file + ".unwrap_cache", FileAccess::WRITE);
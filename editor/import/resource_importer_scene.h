@@ -216,7 +216,8 @@ class ResourceImporterScene : public ResourceImporter {
 
 	Array _get_skinned_pose_transforms(ImporterMeshInstance3D *p_src_mesh_node);
 	void _replace_owner(Node *p_node, Node *p_scene, Node *p_new_owner);
-	Node *_generate_meshes(Node *p_node, const Dictionary &p_mesh_data, bool p_generate_lods, bool p_create_shadow_meshes, LightBakeMode p_light_bake_mode, float p_lightmap_texel_size, const Vector<uint8_t> &p_src_lightmap_cache, Vector<Vector<uint8_t>> &r_lightmap_caches);
+	Node *_generate_meshes(Node *p_node, const Dictionary &p_mesh_data, bool p_generate_lods, bool p_create_shadow_meshes, LightBakeMode p_light_bake_mode, float p_lightmap_texel_size, const Vector<uint8_t> &p_src_lightmap_cache, Vector<Vector<uint8_t>> &r_lightmap_caches, const Dictionary &p_src_lod_cache, Dictionary &r_lod_caches);
+	void _generate_lods_and_shadow_mesh(const Ref<ImporterMesh> &p_mesh, bool p_generate_lods, bool p_create_shadow_mesh, float p_merge_angle, float p_split_angle, const Array &p_skin_pose_transform_array, const Dictionary &p_src_lod_cache, Dictionary &r_lod_caches);
 	void _add_shapes(Node *p_node, const Vector<Ref<Shape3D>> &p_shapes);
 
 	enum AnimationImportTracks {
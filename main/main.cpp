@@ -488,6 +488,12 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --debug-avoidance                 Show navigation avoidance debug visuals when running the scene.\n");
 	OS::get_singleton()->print("  --debug-stringnames               Print all StringName allocations to stdout when the engine quits.\n");
 	OS::get_singleton()->print("  --debug-canvas-item-redraw        Display a rectangle each time a canvas item requests a redraw (useful to troubleshoot low processor mode).\n");
+#ifdef MODULE_GDSCRIPT_ENABLED
+	OS::get_singleton()->print("  --gdscript-sampling-profiler <path>\n");
+	OS::get_singleton()->print("                                    Sample GDScript call stacks while running and write them to <path> in folded stack format (for flame graph tools) on exit.\n");
+	OS::get_singleton()->print("  --gdscript-sampling-interval <usec>\n");
+	OS::get_singleton()->print("                                    Set the interval between two samples of --gdscript-sampling-profiler (default: 1000).\n");
+#endif // MODULE_GDSCRIPT_ENABLED
 #endif
 	OS::get_singleton()->print("  --max-fps <fps>                   Set a maximum number of frames per second rendered (can be used to limit power usage). A value of 0 results in unlimited framerate.\n");
 	OS::get_singleton()->print("  --frame-delay <ms>                Simulate high CPU load (delay each frame by <ms> milliseconds). Do not use as a FPS limiter; use --max-fps instead.\n");
@@ -2110,6 +2116,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	GLOBAL_DEF("debug/settings/stdout/print_fps", false);
 	GLOBAL_DEF("debug/settings/stdout/print_gpu_profile", false);
+	ResourceLoader::set_print_load_order(GLOBAL_DEF("debug/settings/stdout/print_load_order", false));
 	GLOBAL_DEF("debug/settings/stdout/verbose_stdout", false);
 
 	if (!OS::get_singleton()->_verbose_stdout) { // Not manually overridden.
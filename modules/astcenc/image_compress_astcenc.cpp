@@ -30,11 +30,33 @@
 
 #include "image_compress_astcenc.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/safe_refcount.h"
 
 #include <astcenc.h>
 
+// Mip levels with fewer blocks than this are compressed on the calling thread only.
+static const unsigned int ASTCENC_MIN_BLOCKS_FOR_THREADS = 1024;
+
+struct ASTCEncCompressJob {
+	astcenc_context *context = nullptr;
+	astcenc_image *image = nullptr;
+	const astcenc_swizzle *swizzle = nullptr;
+	uint8_t *dest = nullptr;
+	size_t dest_len = 0;
+	SafeNumeric<uint32_t> status; // Last error reported by any thread, ASTCENC_SUCCESS otherwise.
+};
+
+static void _compress_astc_thread(void *p_job, uint32_t p_thread_index) {
+	ASTCEncCompressJob *job = static_cast<ASTCEncCompressJob *>(p_job);
+	astcenc_error status = astcenc_compress_image(job->context, job->image, job->swizzle, job->dest, job->dest_len, p_thread_index);
+	if (status != ASTCENC_SUCCESS) {
+		job->status.set(status);
+	}
+}
+
 void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
 
@@ -115,7 +137,9 @@ void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 	// Context allocation.
 
 	astcenc_context *context;
-	const unsigned int thread_count = 1; // Godot compresses multiple images each on a thread, which is more efficient for large amount of images imported.
+	// Every thread of the pool works on the same mip level, the astcenc context
+	// splits the blocks between the threads that join it.
+	const unsigned int thread_count = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
 	status = astcenc_context_alloc(&config, thread_count, &context);
 	ERR_FAIL_COND_MSG(status != ASTCENC_SUCCESS,
 			vformat("astcenc: Context allocation failed: %s.", astcenc_get_error_string(status)));
@@ -156,7 +180,20 @@ void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 			ASTCENC_SWZ_R, ASTCENC_SWZ_G, ASTCENC_SWZ_B, ASTCENC_SWZ_A
 		};
 
-		status = astcenc_compress_image(context, &image, &swizzle, dest_mip_write, comp_len, 0);
+		if (thread_count > 1 && block_count_x * block_count_y >= ASTCENC_MIN_BLOCKS_FOR_THREADS) {
+			ASTCEncCompressJob job;
+			job.context = context;
+			job.image = &image;
+			job.swizzle = &swizzle;
+			job.dest = dest_mip_write;
+			job.dest_len = comp_len;
+
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_compress_astc_thread, &job, thread_count, thread_count, true, SNAME("ASTC Compress"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			status = (astcenc_error)job.status.get();
+		} else {
+			status = astcenc_compress_image(context, &image, &swizzle, dest_mip_write, comp_len, 0);
+		}
 
 		ERR_BREAK_MSG(status != ASTCENC_SUCCESS,
 				vformat("astcenc: ASTC image compression failed: %s.", astcenc_get_error_string(status)));
@@ -169,7 +206,8 @@ void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 
 	r_img->set_data(width, height, mipmaps, target_format, dest_data);
 
-	print_verbose(vformat("astcenc: Encoding took %s ms.", rtos(OS::get_singleton()->get_ticks_msec() - start_time)));
+	const uint64_t elapsed_msec = MAX<uint64_t>(OS::get_singleton()->get_ticks_msec() - start_time, 1);
+	print_verbose(vformat("astcenc: Encoding took %s ms (%s MPixels/s).", rtos(elapsed_msec), rtos(Math::snapped(double(width) * height / (elapsed_msec * 1000.0), 0.01))));
 }
 
 void _decompress_astc(Image *r_img) {
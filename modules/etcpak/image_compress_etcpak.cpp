@@ -30,8 +30,10 @@
 
 #include "image_compress_etcpak.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 
 #include <ProcessDxtc.hpp>
 #include <ProcessRGB.hpp>
@@ -88,6 +90,46 @@ void _compress_bc(Image *r_img, Image::UsedChannels p_channels) {
 	_compress_etcpak(type, r_img);
 }
 
+// Number of 4-pixel block rows compressed by a single worker task.
+static const int ETCPAK_BLOCK_ROWS_PER_TASK = 8;
+
+struct EtcpakBlockRowsTask {
+	const uint32_t *src = nullptr;
+	uint64_t *dest = nullptr;
+	uint32_t blocks = 0;
+	int width = 0;
+};
+
+struct EtcpakJobQueue {
+	EtcpakType type = EtcpakType::ETCPAK_TYPE_ETC1;
+	const EtcpakBlockRowsTask *tasks = nullptr;
+};
+
+static void _digest_block_rows_task(void *p_job_queue, uint32_t p_index) {
+	const EtcpakJobQueue *job_queue = static_cast<const EtcpakJobQueue *>(p_job_queue);
+	const EtcpakBlockRowsTask &task = job_queue->tasks[p_index];
+
+	switch (job_queue->type) {
+		case EtcpakType::ETCPAK_TYPE_ETC1:
+			CompressEtc1RgbDither(task.src, task.dest, task.blocks, task.width);
+			break;
+		case EtcpakType::ETCPAK_TYPE_ETC2:
+			CompressEtc2Rgb(task.src, task.dest, task.blocks, task.width, true);
+			break;
+		case EtcpakType::ETCPAK_TYPE_ETC2_ALPHA:
+		case EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG:
+			CompressEtc2Rgba(task.src, task.dest, task.blocks, task.width, true);
+			break;
+		case EtcpakType::ETCPAK_TYPE_DXT1:
+			CompressDxt1Dither(task.src, task.dest, task.blocks, task.width);
+			break;
+		case EtcpakType::ETCPAK_TYPE_DXT5:
+		case EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG:
+			CompressDxt5(task.src, task.dest, task.blocks, task.width);
+			break;
+	}
+}
+
 void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
 
@@ -177,7 +219,14 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 	uint8_t *dest_write = dest_data.ptrw();
 
 	int mip_count = mipmaps ? Image::get_image_required_mipmaps(width, height, target_format) : 0;
-	Vector<uint32_t> padded_src;
+
+	// Two 64-bit words per block for formats with an alpha (or second channel) block.
+	const int block_words = (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) ? 2 : 1;
+
+	// Split every mip level into bands of block rows, so large images and
+	// all their mip levels are compressed in parallel.
+	LocalVector<EtcpakBlockRowsTask> tasks;
+	LocalVector<Vector<uint32_t>> padded_mips;
 
 	for (int i = 0; i < mip_count + 1; i++) {
 		// Get write mip metrics for target image.
@@ -190,7 +239,6 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 		// Block size. Align stride to multiple of 4 (RGBA8).
 		int mip_w = (orig_mip_w + 3) & ~3;
 		int mip_h = (orig_mip_h + 3) & ~3;
-		const uint32_t blocks = mip_w * mip_h / 16;
 
 		// Get mip data from source image for reading.
 		int src_mip_ofs = r_img->get_mipmap_offset(i);
@@ -198,6 +246,7 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 
 		// Pad textures to nearest block by smearing.
 		if (mip_w != orig_mip_w || mip_h != orig_mip_h) {
+			Vector<uint32_t> padded_src;
 			padded_src.resize(mip_w * mip_h);
 			uint32_t *ptrw = padded_src.ptrw();
 			int x = 0, y = 0;
@@ -216,26 +265,32 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 					ptrw[mip_w * y + x] = ptrw[mip_w * y + x - mip_w];
 				}
 			}
-			// Override the src_mip_read pointer to our temporary Vector.
+			// Keep the padded data alive until all tasks are done, and read from it instead.
+			padded_mips.push_back(padded_src);
 			src_mip_read = padded_src.ptr();
 		}
-		if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC1) {
-			CompressEtc1RgbDither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2) {
-			CompressEtc2Rgb(src_mip_read, dest_mip_write, blocks, mip_w, true);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG) {
-			CompressEtc2Rgba(src_mip_read, dest_mip_write, blocks, mip_w, true);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT1) {
-			CompressDxt1Dither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) {
-			CompressDxt5(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else {
-			ERR_FAIL_MSG("etcpak: Invalid or unsupported compression format.");
+
+		const int blocks_per_row = mip_w / 4;
+		const int block_rows = mip_h / 4;
+		for (int row = 0; row < block_rows; row += ETCPAK_BLOCK_ROWS_PER_TASK) {
+			EtcpakBlockRowsTask task;
+			task.src = src_mip_read + row * 4 * mip_w;
+			task.dest = dest_mip_write + row * blocks_per_row * block_words;
+			task.blocks = MIN(ETCPAK_BLOCK_ROWS_PER_TASK, block_rows - row) * blocks_per_row;
+			task.width = mip_w;
+			tasks.push_back(task);
 		}
 	}
 
+	EtcpakJobQueue job_queue;
+	job_queue.type = p_compresstype;
+	job_queue.tasks = tasks.ptr();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_digest_block_rows_task, &job_queue, tasks.size(), -1, true, SNAME("Etcpak Compress"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
 	// Replace original image with compressed one.
 	r_img->set_data(width, height, mipmaps, target_format, dest_data);
 
-	print_verbose(vformat("etcpak: Encoding took %s ms.", rtos(OS::get_singleton()->get_ticks_msec() - start_time)));
+	const uint64_t elapsed_msec = MAX<uint64_t>(OS::get_singleton()->get_ticks_msec() - start_time, 1);
+	print_verbose(vformat("etcpak: Encoding took %s ms (%s MPixels/s).", rtos(elapsed_msec), rtos(Math::snapped(double(width) * height / (elapsed_msec * 1000.0), 0.01))));
 }
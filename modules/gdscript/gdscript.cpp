@@ -425,6 +425,7 @@ void GDScript::set_source_code(const String &p_code) {
 		return;
 	}
 	source = p_code;
+	binary_tokens.clear();
 #ifdef TOOLS_ENABLED
 	source_changed_cache = true;
 #endif
@@ -496,7 +497,7 @@ bool GDScript::_update_exports(bool *r_err, bool p_recursive_call, PlaceHolderSc
 
 		GDScriptParser parser;
 		GDScriptAnalyzer analyzer(&parser);
-		Error err = parser.parse(source, path, false);
+		Error err = binary_tokens.is_empty() ? parser.parse(source, path, false) : parser.parse_binary(binary_tokens, path);
 
 		if (err == OK && analyzer.analyze() == OK) {
 			const GDScriptParser::ClassNode *c = parser.get_tree();
@@ -723,7 +724,7 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 		Ref<GDScript> cached_script = GDScriptCache::get_cached_script(source_path);
 		if (!source_path.is_empty() && cached_script.is_null()) {
-			MutexLock lock(GDScriptCache::singleton->mutex);
+			GDScriptCache::CacheLock lock;
 			GDScriptCache::singleton->shallow_gdscript_cache[source_path] = Ref<GDScript>(this);
 		}
 	}
@@ -738,7 +739,7 @@ Error GDScript::reload(bool p_keep_state) {
 
 	valid = false;
 	GDScriptParser parser;
-	Error err = parser.parse(source, path, false);
+	Error err = binary_tokens.is_empty() ? parser.parse(source, path, false) : parser.parse_binary(binary_tokens, path);
 	if (err) {
 		if (EngineDebugger::is_active()) {
 			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
@@ -1012,6 +1013,14 @@ Error GDScript::load_source_code(const String &p_path) {
 		return OK;
 	}
 
+	Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(p_path);
+	if (!tokens.is_empty()) {
+		set_binary_tokens_source(tokens);
+		path = p_path;
+		path_valid = true;
+		return OK;
+	}
+
 	Vector<uint8_t> sourcef;
 	Error err;
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
@@ -1038,6 +1047,7 @@ Error GDScript::load_source_code(const String &p_path) {
 	}
 
 	source = s;
+	binary_tokens.clear();
 	path = p_path;
 	path_valid = true;
 #ifdef TOOLS_ENABLED
@@ -1048,6 +1058,11 @@ Error GDScript::load_source_code(const String &p_path) {
 	return OK;
 }
 
+void GDScript::set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens) {
+	binary_tokens = p_binary_tokens;
+	source = String();
+}
+
 const HashMap<StringName, GDScriptFunction *> &GDScript::debug_get_member_functions() const {
 	return member_functions;
 }
@@ -1315,6 +1330,33 @@ void GDScript::_get_dependencies(RBSet<GDScript *> &p_dependencies, const GDScri
 	}
 }
 
+SafeNumeric<uint64_t> GDScript::method_cache_last_epoch;
+
+uint64_t GDScript::_get_method_cache_epoch() const {
+	uint64_t epoch = 0;
+	for (const GDScript *scr = this; scr; scr = scr->_base) {
+		epoch = MAX(epoch, scr->method_cache_epoch.get());
+	}
+	return epoch;
+}
+
+GDScriptFunction *GDScript::_get_cached_method(const StringName &p_method, uint64_t p_epoch) const {
+	MethodCacheEntry *entry = method_cache.find(p_epoch, [&](const MethodCacheEntry &p_entry) {
+		return p_entry.method == p_method;
+	});
+	return entry ? entry->function : nullptr;
+}
+
+void GDScript::_add_cached_method(const StringName &p_method, GDScriptFunction *p_function, uint64_t p_epoch) {
+	MethodCacheEntry entry;
+	entry.method = p_method;
+	entry.function = p_function;
+	entry.epoch = p_epoch;
+	method_cache.add(entry, [&](const MethodCacheEntry &p_other) {
+		return p_other.method == p_method;
+	});
+}
+
 GDScript::GDScript() :
 		script_list(this) {
 	{
@@ -1494,6 +1536,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		clear_data->functions.insert(E.value);
 	}
 	member_functions.clear();
+	_invalidate_method_cache();
 
 	for (KeyValue<StringName, MemberInfo> &E : member_indices) {
 		clear_data->scripts.insert(E.value.data_type.script_type_ref);
@@ -1553,6 +1596,9 @@ GDScript::~GDScript() {
 	}
 	destructing = true;
 
+	// Another script may be allocated at the same address, don't let cached accesses mistake it for this one.
+	GDScriptFunction::invalidate_named_access_caches();
+
 	clear();
 
 	{
@@ -1931,9 +1977,18 @@ Variant GDScriptInstance::callp(const StringName &p_method, const Variant **p_ar
 		// Reset this back for the regular call.
 		sptr = script.ptr();
 	}
+
+	// Read the epoch before resolving, so a function freed meanwhile can't be cached as current.
+	const uint64_t epoch = sptr->_get_method_cache_epoch();
+	GDScriptFunction *cached = sptr->_get_cached_method(p_method, epoch);
+	if (cached) {
+		return cached->call(this, p_args, p_argcount, r_error);
+	}
+
 	while (sptr) {
 		HashMap<StringName, GDScriptFunction *>::Iterator E = sptr->member_functions.find(p_method);
 		if (E) {
+			script->_add_cached_method(p_method, E->value, epoch);
 			return E->value->call(this, p_args, p_argcount, r_error);
 		}
 		sptr = sptr->_base;
@@ -2165,6 +2220,8 @@ void GDScriptLanguage::init() {
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
+
+	GDScriptSamplingProfiler::handle_cmdline();
 }
 
 String GDScriptLanguage::get_type() const {
@@ -2176,6 +2233,10 @@ String GDScriptLanguage::get_extension() const {
 }
 
 void GDScriptLanguage::finish() {
+	if (GDScriptSamplingProfiler::get_singleton()) {
+		memdelete(GDScriptSamplingProfiler::get_singleton());
+	}
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2212,6 +2273,8 @@ void GDScriptLanguage::finish() {
 	script_list.clear();
 	function_list.clear();
 
+	GDScriptFunctionState::clear_frame_pool();
+
 	DEV_ASSERT(GDScript::func_ptrs_to_update_main_thread.rc == 1);
 }
 
@@ -2781,7 +2844,14 @@ Ref<GDScript> GDScriptLanguage::get_script_by_fully_qualified_name(const String
 
 Ref<Resource> ResourceFormatLoaderGDScript::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
 	Error err;
-	Ref<GDScript> scr = GDScriptCache::get_full_script(p_path, err, "", p_cache_mode == CACHE_MODE_IGNORE);
+	// Scripts exported as binary tokens are remapped, but are cached under their original path.
+	const String &script_path = p_original_path.is_empty() ? p_path : p_original_path;
+	const bool prefetched = p_cache_mode != CACHE_MODE_IGNORE && GDScriptCache::prefetch_dependencies(script_path);
+	Ref<GDScript> scr = GDScriptCache::get_full_script(script_path, err, "", p_cache_mode == CACHE_MODE_IGNORE);
+	if (prefetched) {
+		// Whatever the load didn't use isn't worth keeping around.
+		GDScriptCache::discard_prefetched_parsers();
+	}
 
 	if (err && scr.is_valid()) {
 		// If !scr.is_valid(), the error was likely from scr->load_source_code(), which already generates an error.
@@ -2798,6 +2868,7 @@ Ref<Resource> ResourceFormatLoaderGDScript::load(const String &p_path, const Str
 
 void ResourceFormatLoaderGDScript::get_recognized_extensions(List<String> *p_extensions) const {
 	p_extensions->push_back("gd");
+	p_extensions->push_back("gdc");
 }
 
 bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
@@ -2806,24 +2877,31 @@ bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
 
 String ResourceFormatLoaderGDScript::get_resource_type(const String &p_path) const {
 	String el = p_path.get_extension().to_lower();
-	if (el == "gd") {
+	if (el == "gd" || el == "gdc") {
 		return "GDScript";
 	}
 	return "";
 }
 
 void ResourceFormatLoaderGDScript::get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types) {
-	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
-	ERR_FAIL_COND_MSG(file.is_null(), "Cannot open file '" + p_path + "'.");
+	GDScriptParser parser;
+	const Vector<uint8_t> binary_tokens = GDScriptCache::get_binary_tokens(p_path);
+	if (!binary_tokens.is_empty()) {
+		if (OK != parser.parse_binary(binary_tokens, p_path)) {
+			return;
+		}
+	} else {
+		Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+		ERR_FAIL_COND_MSG(file.is_null(), "Cannot open file '" + p_path + "'.");
 
-	String source = file->get_as_utf8_string();
-	if (source.is_empty()) {
-		return;
-	}
+		String source = file->get_as_utf8_string();
+		if (source.is_empty()) {
+			return;
+		}
 
-	GDScriptParser parser;
-	if (OK != parser.parse(source, p_path, false)) {
-		return;
+		if (OK != parser.parse(source, p_path, false)) {
+			return;
+		}
 	}
 
 	for (const String &E : parser.get_dependencies()) {
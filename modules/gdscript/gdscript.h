@@ -32,6 +32,8 @@
 #define GDSCRIPT_H
 
 #include "gdscript_function.h"
+#include "gdscript_inline_cache.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
@@ -177,6 +179,7 @@ class GDScript : public Script {
 	bool clearing = false;
 	//exported members
 	String source;
+	Vector<uint8_t> binary_tokens; // Set instead of the source code by scripts exported as binary tokens.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -187,6 +190,37 @@ class GDScript : public Script {
 
 	SelfList<GDScriptFunctionState>::List pending_func_states;
 
+	// Methods last resolved by GDScriptInstance::callp(), including inherited ones,
+	// so repeated calls by name (e.g. from signals) skip the lookup up the inheritance chain.
+	enum {
+		METHOD_CACHE_SIZE = 4,
+		METHOD_CACHE_MAX_MISSES = 32, // Past this, too many names are called to be worth caching.
+		METHOD_CACHE_MAX_ALLOCATIONS = 64, // Past this, the scripts were reloaded too many times.
+	};
+
+	struct MethodCacheEntry {
+		StringName method;
+		GDScriptFunction *function = nullptr;
+		uint64_t epoch = 0;
+		MethodCacheEntry *next_allocated = nullptr;
+	};
+
+	GDScriptInlineCache<MethodCacheEntry, METHOD_CACHE_SIZE, METHOD_CACHE_MAX_MISSES, METHOD_CACHE_MAX_ALLOCATIONS> method_cache;
+	// Changed whenever the functions of this script are replaced, to a value never used before by any script.
+	// Entries are tagged with the highest epoch up the inheritance chain, so reloading a base invalidates them too.
+	SafeNumeric<uint64_t> method_cache_epoch;
+	static SafeNumeric<uint64_t> method_cache_last_epoch;
+
+	// Called when the functions of this script are freed, so its own entries can be freed as well.
+	// Entries of inheriting scripts only become stale, they count toward METHOD_CACHE_MAX_ALLOCATIONS.
+	void _invalidate_method_cache() {
+		method_cache_epoch.set(method_cache_last_epoch.increment());
+		method_cache.clear();
+	}
+	uint64_t _get_method_cache_epoch() const;
+	GDScriptFunction *_get_cached_method(const StringName &p_method, uint64_t p_epoch) const;
+	void _add_cached_method(const StringName &p_method, GDScriptFunction *p_function, uint64_t p_epoch);
+
 	GDScriptFunction *_super_constructor(GDScript *p_script);
 	void _super_implicit_constructor(GDScript *p_script, GDScriptInstance *p_instance, Callable::CallError &r_error);
 	GDScriptInstance *_create_instance(const Variant **p_args, int p_argcount, Object *p_owner, bool p_is_ref_counted, Callable::CallError &r_error);
@@ -251,6 +285,7 @@ public:
 		return member_indices[p_member].data_type;
 	}
 	const HashMap<StringName, GDScriptFunction *> &get_member_functions() const { return member_functions; }
+	uint32_t get_method_cache_allocation_count() const { return method_cache.get_allocation_count(); }
 	const Ref<GDScriptNativeClass> &get_native() const { return native; }
 
 	RBSet<GDScript *> get_dependencies();
@@ -297,6 +332,9 @@ public:
 	String get_script_path() const;
 	Error load_source_code(const String &p_path);
 
+	void set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens);
+	const Vector<uint8_t> &get_binary_tokens_source() const { return binary_tokens; }
+
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
 
 	virtual void get_script_method_list(List<MethodInfo> *p_list) const override;
@@ -429,6 +467,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	void _add_global(const StringName &p_name, const Variant &p_value);
 
 	friend class GDScriptInstance;
+	friend class GDScriptSamplingProfiler;
 
 	Mutex mutex;
 
@@ -449,22 +488,37 @@ public:
 	bool debug_break(const String &p_error, bool p_allow_continue = true);
 	bool debug_break_parse(const String &p_file, int p_line, const String &p_error);
 
+	// The call stack is kept for the debugger and for the sampling profiler.
+	_FORCE_INLINE_ static bool is_call_stack_tracked() {
+		return EngineDebugger::is_active() || GDScriptSamplingProfiler::is_running();
+	}
+
 	_FORCE_INLINE_ void enter_function(GDScriptInstance *p_instance, GDScriptFunction *p_function, Variant *p_stack, int *p_ip, int *p_line) {
 		if (unlikely(_call_stack.levels == nullptr)) {
 			_call_stack.levels = memnew_arr(CallLevel, _debug_max_call_stack + 1);
 		}
 
-		if (EngineDebugger::get_script_debugger()->get_lines_left() > 0 && EngineDebugger::get_script_debugger()->get_depth() >= 0) {
-			EngineDebugger::get_script_debugger()->set_depth(EngineDebugger::get_script_debugger()->get_depth() + 1);
+		ScriptDebugger *script_debugger = EngineDebugger::get_script_debugger();
+		if (script_debugger && script_debugger->get_lines_left() > 0 && script_debugger->get_depth() >= 0) {
+			script_debugger->set_depth(script_debugger->get_depth() + 1);
 		}
 
 		if (_call_stack.stack_pos >= _debug_max_call_stack) {
 			//stack overflow
 			_debug_error = vformat("Stack overflow (stack size: %s). Check for infinite recursion in your script.", _debug_max_call_stack);
-			EngineDebugger::get_script_debugger()->debug(this);
+			if (script_debugger) {
+				script_debugger->debug(this);
+			} else {
+				ERR_PRINT(_debug_error);
+			}
 			return;
 		}
 
+		if (_call_stack.stack_pos == 0 && GDScriptSamplingProfiler::is_running()) {
+			// Don't attribute the time spent outside of scripts to the first line that runs.
+			GDScriptSamplingProfiler::discard_pending_samples();
+		}
+
 		_call_stack.levels[_call_stack.stack_pos].stack = p_stack;
 		_call_stack.levels[_call_stack.stack_pos].instance = p_instance;
 		_call_stack.levels[_call_stack.stack_pos].function = p_function;
@@ -474,13 +528,18 @@ public:
 	}
 
 	_FORCE_INLINE_ void exit_function() {
-		if (EngineDebugger::get_script_debugger()->get_lines_left() > 0 && EngineDebugger::get_script_debugger()->get_depth() >= 0) {
-			EngineDebugger::get_script_debugger()->set_depth(EngineDebugger::get_script_debugger()->get_depth() - 1);
+		ScriptDebugger *script_debugger = EngineDebugger::get_script_debugger();
+		if (script_debugger && script_debugger->get_lines_left() > 0 && script_debugger->get_depth() >= 0) {
+			script_debugger->set_depth(script_debugger->get_depth() - 1);
 		}
 
 		if (_call_stack.stack_pos == 0) {
 			_debug_error = "Stack Underflow (Engine Bug)";
-			EngineDebugger::get_script_debugger()->debug(this);
+			if (script_debugger) {
+				script_debugger->debug(this);
+			} else {
+				ERR_PRINT(_debug_error);
+			}
 			return;
 		}
 
@@ -2938,6 +2938,44 @@ const char *check_for_renamed_identifier(String identifier, GDScriptParser::Node
 }
 #endif // SUGGEST_GODOT4_RENAMES
 
+void GDScriptAnalyzer::reduce_builtin_method_call(GDScriptParser::CallNode *p_call, const GDScriptParser::DataType &p_base_type, BitField<MethodFlags> p_method_flags) {
+	// Builtin methods are pure unless they work on references or randomness, so with constant
+	// arguments they can be called on compilation, like math utility functions.
+	const Variant::Type builtin_type = p_base_type.builtin_type;
+	if (builtin_type == Variant::OBJECT || builtin_type == Variant::CALLABLE || builtin_type == Variant::SIGNAL || p_call->function_name == SNAME("pick_random")) {
+		return;
+	}
+
+	Vector<const Variant *> args;
+	for (int i = 0; i < p_call->arguments.size(); i++) {
+		args.push_back(&(p_call->arguments[i]->reduced_value));
+	}
+
+	Variant value;
+	Callable::CallError err;
+	if (p_base_type.is_meta_type) {
+		if (!p_method_flags.has_flag(METHOD_FLAG_STATIC)) {
+			return;
+		}
+		Variant::call_static(builtin_type, p_call->function_name, (const Variant **)args.ptr(), args.size(), value, err);
+	} else {
+		const GDScriptParser::ExpressionNode *base = static_cast<GDScriptParser::SubscriptNode *>(p_call->callee)->base;
+		if (!base->is_constant || !Variant::is_builtin_method_const(builtin_type, p_call->function_name)) {
+			return;
+		}
+		Variant base_value = base->reduced_value;
+		base_value.callp(p_call->function_name, (const Variant **)args.ptr(), args.size(), value, err);
+	}
+
+	// Leave errors to runtime, and keep shared containers out of the constants.
+	if (err.error != Callable::CallError::CALL_OK || value.get_type() == Variant::OBJECT || value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY || value.get_type() == Variant::CALLABLE || value.get_type() == Variant::SIGNAL) {
+		return;
+	}
+
+	p_call->is_constant = true;
+	p_call->reduced_value = value;
+}
+
 void GDScriptAnalyzer::reduce_call(GDScriptParser::CallNode *p_call, bool p_is_await, bool p_is_root) {
 	bool all_is_constant = true;
 	HashMap<int, GDScriptParser::ArrayNode *> arrays; // For array literal to potentially type when passing.
@@ -3371,6 +3409,10 @@ void GDScriptAnalyzer::reduce_call(GDScriptParser::CallNode *p_call, bool p_is_a
 #endif // DEBUG_ENABLED
 
 		call_type = return_type;
+
+		if (all_is_constant && callee_type == GDScriptParser::Node::SUBSCRIPT && !is_constructor && base_type.kind == GDScriptParser::DataType::BUILTIN) {
+			reduce_builtin_method_call(p_call, base_type, method_flags);
+		}
 	} else {
 		bool found = false;
 
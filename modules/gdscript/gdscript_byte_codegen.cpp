@@ -395,6 +395,11 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (named_access_site_count) {
+		function->_named_access_sites = memnew_arr(GDScriptFunction::NamedAccessSite, named_access_site_count);
+		function->_named_access_site_count = named_access_site_count;
+	}
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
@@ -581,6 +586,36 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+static GDScriptFunction::Opcode _get_numeric_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type != p_right_type) {
+		return GDScriptFunction::OPCODE_END;
+	}
+	if (p_left_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT;
+			default:
+				break;
+		}
+	}
+	return GDScriptFunction::OPCODE_END;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	// Avoid validated evaluator for modulo and division when operands are int, since there's no check for division by zero.
 	if (HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || p_left_operand.type.builtin_type != Variant::INT || p_right_operand.type.builtin_type != Variant::INT)) {
@@ -592,9 +627,20 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		// Plain int and float arithmetic is done inline, without calling into the evaluator.
+		GDScriptFunction::Opcode numeric_opcode = _get_numeric_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (numeric_opcode != GDScriptFunction::OPCODE_END && (p_target.mode == Address::TEMPORARY || (HAS_BUILTIN_TYPE(p_target) && p_target.type.builtin_type == p_left_operand.type.builtin_type))) {
+			append_opcode(numeric_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		last_validated_operator_pos = opcodes.size();
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -660,18 +706,32 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 	}
 }
 
-void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
+int GDScriptByteCodeGenerator::write_jump_if_not(const Address &p_condition) {
+	// If the condition was just computed by a validated operator, fuse both into a single instruction.
+	// The operator keeps writing its result, so the condition stays valid for anything reading it later.
+	if (p_condition.mode == Address::TEMPORARY && last_validated_operator_pos >= 0 && last_validated_operator_pos + 5 == opcodes.size()) {
+		const Vector<int> &indices = temporaries[p_condition.address].bytecode_indices;
+		if (!indices.is_empty() && indices[indices.size() - 1] == last_validated_operator_pos + 3) {
+			opcodes.write[last_validated_operator_pos] = GDScriptFunction::OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED;
+			last_validated_operator_pos = -1;
+			int jump_pos = opcodes.size();
+			append(0); // Jump target, will be patched.
+			return jump_pos;
+		}
+	}
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_left_operand);
-	logic_op_jump_pos1.push_back(opcodes.size());
+	append(p_condition);
+	int jump_pos = opcodes.size();
 	append(0); // Jump target, will be patched.
+	return jump_pos;
+}
+
+void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
+	logic_op_jump_pos1.push_back(write_jump_if_not(p_left_operand));
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
-	logic_op_jump_pos2.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	logic_op_jump_pos2.push_back(write_jump_if_not(p_right_operand));
 }
 
 void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
@@ -829,6 +889,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append(named_access_site_count++);
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -847,6 +908,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append(named_access_site_count++);
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -945,6 +1007,45 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 	}
 }
 
+void GDScriptByteCodeGenerator::write_assign_to_initialized_local(const Address &p_target, const Address &p_source) {
+	// The local already holds a value of its type, so primitives only need their payload copied.
+	if (HAS_BUILTIN_TYPE(p_target) && HAS_BUILTIN_TYPE(p_source) && p_target.type.builtin_type == p_source.type.builtin_type) {
+		GDScriptFunction::Opcode opcode = GDScriptFunction::OPCODE_END;
+		switch (p_target.type.builtin_type) {
+			case Variant::BOOL:
+				opcode = GDScriptFunction::OPCODE_ASSIGN_BOOL;
+				break;
+			case Variant::INT:
+				opcode = GDScriptFunction::OPCODE_ASSIGN_INT;
+				break;
+			case Variant::FLOAT:
+				opcode = GDScriptFunction::OPCODE_ASSIGN_FLOAT;
+				break;
+			case Variant::VECTOR2:
+				opcode = GDScriptFunction::OPCODE_ASSIGN_VECTOR2;
+				break;
+			case Variant::VECTOR2I:
+				opcode = GDScriptFunction::OPCODE_ASSIGN_VECTOR2I;
+				break;
+			case Variant::VECTOR3:
+				opcode = GDScriptFunction::OPCODE_ASSIGN_VECTOR3;
+				break;
+			case Variant::VECTOR3I:
+				opcode = GDScriptFunction::OPCODE_ASSIGN_VECTOR3I;
+				break;
+			default:
+				break;
+		}
+		if (opcode != GDScriptFunction::OPCODE_END) {
+			append_opcode(opcode);
+			append(p_target);
+			append(p_source);
+			return;
+		}
+	}
+	write_assign(p_target, p_source);
+}
+
 void GDScriptByteCodeGenerator::write_assign_true(const Address &p_target) {
 	append_opcode(GDScriptFunction::OPCODE_ASSIGN_TRUE);
 	append(p_target);
@@ -1408,10 +1509,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	if_jmp_addrs.push_back(opcodes.size());
-	append(0); // Jump destination, will be patched.
+	if_jmp_addrs.push_back(write_jump_if_not(p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_else() {
@@ -1612,14 +1710,12 @@ void GDScriptByteCodeGenerator::write_endfor() {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_validated_operator_pos = -1;
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	while_jmp_addrs.push_back(opcodes.size());
-	append(0); // End of loop address, will be patched.
+	while_jmp_addrs.push_back(write_jump_if_not(p_condition)); // End of loop address, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_endwhile() {
@@ -34,8 +34,11 @@
 #include "gdscript_analyzer.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
+#include "gdscript_tokenizer_buffer.h"
 
 #include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 #include "scene/resources/packed_scene.h"
 
@@ -58,6 +61,15 @@ GDScriptAnalyzer *GDScriptParserRef::get_analyzer() {
 	return analyzer;
 }
 
+void GDScriptParserRef::parse() {
+	const Vector<uint8_t> binary_tokens = GDScriptCache::get_binary_tokens(path);
+	if (binary_tokens.is_empty()) {
+		result = parser->parse(GDScriptCache::get_source_code(path), path, false);
+	} else {
+		result = parser->parse_binary(binary_tokens, path);
+	}
+}
+
 Error GDScriptParserRef::raise_status(Status p_new_status) {
 	ERR_FAIL_NULL_V(parser, ERR_INVALID_DATA);
 
@@ -69,7 +81,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 		switch (status) {
 			case EMPTY:
 				status = PARSED;
-				result = parser->parse(GDScriptCache::get_source_code(path), path, false);
+				parse();
 				break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -122,18 +134,23 @@ void GDScriptParserRef::clear() {
 GDScriptParserRef::~GDScriptParserRef() {
 	clear();
 
-	MutexLock lock(GDScriptCache::singleton->mutex);
-	GDScriptCache::singleton->parser_map.erase(path);
+	GDScriptCache::CacheLock lock;
+	// Prefetched refs that failed to parse were never published.
+	HashMap<String, GDScriptParserRef *>::Iterator E = GDScriptCache::singleton->parser_map.find(path);
+	if (E && E->value == this) {
+		GDScriptCache::singleton->parser_map.remove(E);
+	}
 }
 
 GDScriptCache *GDScriptCache::singleton = nullptr;
+thread_local int GDScriptCache::lock_depth = 0;
 
 void GDScriptCache::move_script(const String &p_from, const String &p_to) {
 	if (singleton == nullptr || p_from == p_to) {
 		return;
 	}
 
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 
 	if (singleton->cleared) {
 		return;
@@ -167,7 +184,7 @@ void GDScriptCache::remove_script(const String &p_path) {
 		return;
 	}
 
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 
 	if (singleton->cleared) {
 		return;
@@ -187,17 +204,28 @@ void GDScriptCache::remove_script(const String &p_path) {
 		singleton->parser_map.erase(p_path);
 	}
 
+	singleton->prefetched_parsers.erase(p_path);
 	singleton->dependencies.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
 }
 
 Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptParserRef::Status p_status, Error &r_error, const String &p_owner) {
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 	Ref<GDScriptParserRef> ref;
 	if (!p_owner.is_empty()) {
 		singleton->dependencies[p_owner].insert(p_path);
 	}
+	HashMap<String, PrefetchedParser>::Iterator prefetched = singleton->prefetched_parsers.find(p_path);
+	if (prefetched) {
+		const bool outdated = prefetched->value.modified_time != FileAccess::get_modified_time(ResourceLoader::path_remap(p_path));
+		ref = prefetched->value.ref;
+		singleton->prefetched_parsers.remove(prefetched);
+		if (outdated) {
+			// Edited since it was parsed ahead, parse it again.
+			ref.unref();
+		}
+	}
 	if (singleton->parser_map.has(p_path)) {
 		ref = Ref<GDScriptParserRef>(singleton->parser_map[p_path]);
 		if (ref.is_null()) {
@@ -205,7 +233,7 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 			return ref;
 		}
 	} else {
-		if (!FileAccess::exists(p_path)) {
+		if (!FileAccess::exists(ResourceLoader::path_remap(p_path))) {
 			r_error = ERR_FILE_NOT_FOUND;
 			return ref;
 		}
@@ -220,6 +248,110 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 	return ref;
 }
 
+void GDScriptCache::_parse_dependency(void *p_userdata, uint32_t p_index) {
+	GDScriptParserRef **refs = (GDScriptParserRef **)p_userdata;
+	refs[p_index]->parse();
+}
+
+bool GDScriptCache::prefetch_dependencies(const String &p_path) {
+	// Waiting on the pool from one of its own threads could starve it, so only the main thread fans out.
+	// Loads on other threads keep parsing dependencies one at a time, when the analyzer reaches them.
+	if (singleton == nullptr || lock_depth > 0 || !Thread::is_main_thread() || WorkerThreadPool::get_singleton() == nullptr || WorkerThreadPool::get_singleton()->get_thread_count() < 2) {
+		return false;
+	}
+
+	HashSet<String> paths;
+	HashSet<StringName> class_names;
+	HashSet<String> visited;
+	paths.insert(p_path);
+
+	// Parsing doesn't need other scripts, so every wave of not yet seen dependencies is parsed in parallel.
+	// Analysis and compilation still happen in dependency order on the calling thread.
+	// The lock is only held to look at and publish to the cache, never while waiting on the pool.
+	while (!paths.is_empty() || !class_names.is_empty()) {
+		Vector<Ref<GDScriptParserRef>> wave;
+		{
+			CacheLock lock;
+			if (singleton->cleared) {
+				return false;
+			}
+
+			for (const StringName &class_name : class_names) {
+				if (ScriptServer::is_global_class(class_name) && ScriptServer::get_global_class_language(class_name) == "GDScript") {
+					paths.insert(ScriptServer::get_global_class_path(class_name));
+				}
+			}
+
+			for (const String &path : paths) {
+				if (visited.has(path)) {
+					continue;
+				}
+				visited.insert(path);
+				if (singleton->parser_map.has(path) || singleton->full_gdscript_cache.has(path) || singleton->shallow_gdscript_cache.has(path) || !FileAccess::exists(ResourceLoader::path_remap(path))) {
+					continue;
+				}
+				Ref<GDScriptParserRef> ref;
+				ref.instantiate();
+				ref->parser = memnew(GDScriptParser);
+				ref->path = path;
+				wave.push_back(ref);
+			}
+		}
+
+		if (wave.is_empty()) {
+			break;
+		}
+
+		Vector<GDScriptParserRef *> wave_refs;
+		wave_refs.resize(wave.size());
+		for (int i = 0; i < wave.size(); i++) {
+			wave_refs.write[i] = wave[i].ptr();
+		}
+
+		if (wave.size() == 1) {
+			wave_refs[0]->parse();
+		} else {
+			WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&_parse_dependency, wave_refs.ptrw(), wave_refs.size(), -1, true, SNAME("GDScriptParseDependencies"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+		}
+
+		paths.clear();
+		class_names.clear();
+
+		CacheLock lock;
+		for (const Ref<GDScriptParserRef> &ref : wave) {
+			// Scripts with errors are parsed again when requested, so the errors get reported then.
+			// Another thread may also have parsed the same script meanwhile.
+			if (ref->result != OK || singleton->parser_map.has(ref->path)) {
+				continue;
+			}
+			ref->status = GDScriptParserRef::PARSED;
+			singleton->parser_map[ref->path] = ref.ptr();
+			PrefetchedParser &prefetched = singleton->prefetched_parsers[ref->path];
+			prefetched.ref = ref;
+			prefetched.modified_time = FileAccess::get_modified_time(ResourceLoader::path_remap(ref->path));
+
+			for (const String &path : ref->parser->get_dependency_paths()) {
+				paths.insert(path);
+			}
+			for (const StringName &class_name : ref->parser->get_dependency_class_names()) {
+				class_names.insert(class_name);
+			}
+		}
+	}
+
+	return true;
+}
+
+void GDScriptCache::discard_prefetched_parsers() {
+	if (singleton == nullptr) {
+		return;
+	}
+
+	CacheLock lock;
+	singleton->prefetched_parsers.clear();
+}
+
 String GDScriptCache::get_source_code(const String &p_path) {
 	Vector<uint8_t> source_file;
 	Error err;
@@ -239,8 +371,26 @@ String GDScriptCache::get_source_code(const String &p_path) {
 	return source;
 }
 
+Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() != "gdc") {
+		return Vector<uint8_t>();
+	}
+
+	Error err;
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(remapped_path, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, Vector<uint8_t>(), vformat(R"(Cannot read binary GDScript tokens from "%s".)", remapped_path));
+
+	if (!GDScriptTokenizerBuffer::is_compatible(buffer) && remapped_path != p_path && FileAccess::exists(p_path)) {
+		// Tokens made by another engine version, but the source code is still available.
+		WARN_PRINT(vformat(R"(Binary GDScript tokens in "%s" were made by a different engine version, loading "%s" instead.)", remapped_path, p_path));
+		return Vector<uint8_t>();
+	}
+	return buffer;
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 	if (!p_owner.is_empty()) {
 		singleton->dependencies[p_owner].insert(p_path);
 	}
@@ -270,7 +420,7 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 }
 
 Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_error, const String &p_owner, bool p_update_from_disk) {
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 
 	if (!p_owner.is_empty()) {
 		singleton->dependencies[p_owner].insert(p_path);
@@ -294,6 +444,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 	}
 
 	if (p_update_from_disk) {
+		singleton->prefetched_parsers.erase(p_path);
 		r_error = script->load_source_code(p_path);
 		if (r_error) {
 			return script;
@@ -312,7 +463,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 }
 
 Ref<GDScript> GDScriptCache::get_cached_script(const String &p_path) {
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 
 	if (singleton->full_gdscript_cache.has(p_path)) {
 		return singleton->full_gdscript_cache[p_path];
@@ -326,7 +477,7 @@ Ref<GDScript> GDScriptCache::get_cached_script(const String &p_path) {
 }
 
 Error GDScriptCache::finish_compiling(const String &p_owner) {
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 
 	// Mark this as compiled.
 	Ref<GDScript> script = get_cached_script(p_owner);
@@ -362,7 +513,7 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 }
 
 Ref<PackedScene> GDScriptCache::get_packed_scene(const String &p_path, Error &r_error, const String &p_owner) {
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 
 	String path = p_path;
 	if (path.begins_with("uid://")) {
@@ -401,7 +552,7 @@ void GDScriptCache::clear_unreferenced_packed_scenes() {
 		return;
 	}
 
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 
 	if (singleton->cleared) {
 		return;
@@ -422,7 +573,7 @@ void GDScriptCache::clear() {
 		return;
 	}
 
-	MutexLock lock(singleton->mutex);
+	CacheLock lock;
 
 	if (singleton->cleared) {
 		return;
@@ -443,6 +594,7 @@ void GDScriptCache::clear() {
 	singleton->packed_scene_cache.clear();
 
 	parser_map_refs.clear();
+	singleton->prefetched_parsers.clear();
 	singleton->parser_map.clear();
 	singleton->shallow_gdscript_cache.clear();
 	singleton->full_gdscript_cache.clear();
@@ -62,6 +62,8 @@ private:
 
 	friend class GDScriptCache;
 
+	void parse();
+
 public:
 	bool is_valid() const;
 	Status get_status() const;
@@ -84,6 +86,13 @@ class GDScriptCache {
 	HashMap<String, Ref<PackedScene>> packed_scene_cache;
 	HashMap<String, HashSet<String>> packed_scene_dependencies;
 
+	// Parsed ahead of the analyzer by prefetch_dependencies(), kept alive until requested or the load ends.
+	struct PrefetchedParser {
+		Ref<GDScriptParserRef> ref;
+		uint64_t modified_time = 0;
+	};
+	HashMap<String, PrefetchedParser> prefetched_parsers;
+
 	friend class GDScript;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
@@ -94,11 +103,32 @@ class GDScriptCache {
 
 	Mutex mutex;
 
+	// Times the current thread holds `mutex`. It must not wait on the WorkerThreadPool while holding it,
+	// since pool threads running threaded loads may be waiting for it too.
+	static thread_local int lock_depth;
+
+	class CacheLock {
+	public:
+		CacheLock() {
+			singleton->mutex.lock();
+			lock_depth++;
+		}
+		~CacheLock() {
+			lock_depth--;
+			singleton->mutex.unlock();
+		}
+	};
+
+	static void _parse_dependency(void *p_userdata, uint32_t p_index);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
+	static bool prefetch_dependencies(const String &p_path);
+	static void discard_prefetched_parsers();
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
 	static String get_source_code(const String &p_path);
+	static Vector<uint8_t> get_binary_tokens(const String &p_path);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
@@ -249,6 +249,38 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+static bool _can_operate_in_place(const GDScriptCodeGenerator::Address &p_target, Variant::Operator p_operator, const GDScriptCodeGenerator::Address &p_operand) {
+	// The result can only be written into the target if the operation is validated and yields the target's own type.
+	if (!p_target.type.has_type || p_target.type.kind != GDScriptDataType::BUILTIN) {
+		return false;
+	}
+	switch (p_target.type.builtin_type) {
+		// Math types are computed before the result is stored, so the result may alias the left operand.
+		// Others aren't safe, e.g. Array addition clears the result before reading the operands.
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::QUATERNION:
+		case Variant::COLOR:
+			break;
+		default:
+			return false;
+	}
+	if (!p_operand.type.has_type || p_operand.type.kind != GDScriptDataType::BUILTIN) {
+		return false;
+	}
+	if ((p_operator == Variant::OP_DIVIDE || p_operator == Variant::OP_MODULE) && p_target.type.builtin_type == Variant::INT && p_operand.type.builtin_type == Variant::INT) {
+		// Not validated, needs the division by zero check.
+		return false;
+	}
+	return Variant::get_operator_return_type(p_operator, p_target.type.builtin_type, p_operand.type.builtin_type) == p_target.type.builtin_type;
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer, const GDScriptCodeGenerator::Address &p_index_addr) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -1303,6 +1335,14 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 
 				GDScriptCodeGenerator::Address to_assign;
 				bool has_operation = assignment->operation != GDScriptParser::AssignmentNode::OP_NONE;
+				if (has_operation && !is_member && target.mode == GDScriptCodeGenerator::Address::LOCAL_VARIABLE && !assignment->use_conversion_assign && _can_operate_in_place(target, assignment->variant_op, assigned_value)) {
+					// Compound assignment to a typed local: write the result straight into the local, skipping the temporary and the assign.
+					gen->write_binary_operator(target, assignment->variant_op, target, assigned_value);
+					if (assigned_value.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+						gen->pop_temporary();
+					}
+					return GDScriptCodeGenerator::Address(); // Assignment does not return a value.
+				}
 				if (has_operation) {
 					// Perform operation.
 					GDScriptCodeGenerator::Address op_result = codegen.add_temporary(_gdtype_from_datatype(assignment->get_datatype(), codegen.script));
@@ -1336,6 +1376,9 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 					// Just assign.
 					if (assignment->use_conversion_assign) {
 						gen->write_assign_with_conversion(target, to_assign);
+					} else if (!is_member && target.mode == GDScriptCodeGenerator::Address::LOCAL_VARIABLE) {
+						// The declaration already initialized the local with a value of its type.
+						gen->write_assign_to_initialized_local(target, to_assign);
 					} else {
 						gen->write_assign(target, to_assign);
 					}
@@ -1970,6 +2013,19 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::IF: {
 				const GDScriptParser::IfNode *if_n = static_cast<const GDScriptParser::IfNode *>(s);
+
+				if (if_n->condition->is_constant) {
+					// Only compile the branch that can run.
+					const GDScriptParser::SuiteNode *taken_block = if_n->condition->reduced_value.booleanize() ? if_n->true_block : if_n->false_block;
+					if (taken_block != nullptr) {
+						err = _parse_block(codegen, taken_block);
+						if (err) {
+							return err;
+						}
+					}
+					break;
+				}
+
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, if_n->condition);
 				if (err) {
 					return err;
@@ -2030,6 +2086,11 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			case GDScriptParser::Node::WHILE: {
 				const GDScriptParser::WhileNode *while_n = static_cast<const GDScriptParser::WhileNode *>(s);
 
+				if (while_n->condition->is_constant && !while_n->condition->reduced_value.booleanize()) {
+					// The loop never runs.
+					break;
+				}
+
 				gen->start_while_condition();
 
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, while_n->condition);
@@ -2116,6 +2177,11 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 				GDScriptCodeGenerator::Address local = codegen.locals[lv->identifier->name];
 				GDScriptDataType local_type = _gdtype_from_datatype(lv->get_datatype(), codegen.script);
 
+				if (lv->usages == 0 && lv->assignments == (lv->initializer != nullptr ? 1 : 0) && (lv->initializer == nullptr || lv->initializer->is_constant)) {
+					// Never read nor assigned again, and initializing it has no side effects.
+					break;
+				}
+
 				bool initialized = false;
 				if (lv->initializer != nullptr) {
 					GDScriptCodeGenerator::Address src_address = _parse_expression(codegen, err, lv->initializer);
@@ -2605,6 +2671,7 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 		member_functions.insert(E.key, E.value);
 	}
 	p_script->member_functions.clear();
+	p_script->_invalidate_method_cache();
 	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
 		memdelete(E.value);
 	}
@@ -3174,6 +3241,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 
 	source = p_script->get_path();
 
+	// Member indices are about to be reassigned.
+	GDScriptFunction::invalidate_named_access_caches();
+
 	ScriptLambdaInfo old_lambda_info = _get_script_lambda_replacement_info(p_script);
 
 	// Create scripts for subclasses beforehand so they can be referenced
@@ -141,6 +141,26 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_OPERATOR_NUMERIC(m_op, m_v_type, m_symbol) \
+	case OPCODE_OPERATOR_##m_op##_##m_v_type: {                \
+		text += "operator (";                                  \
+		text += #m_v_type;                                     \
+		text += ") ";                                          \
+		text += DADDR(3);                                      \
+		text += " = ";                                         \
+		text += DADDR(1);                                      \
+		text += " " #m_symbol " ";                             \
+		text += DADDR(2);                                      \
+		incr += 4;                                             \
+	} break
+
+				DISASSEMBLE_OPERATOR_NUMERIC(ADD, INT, +);
+				DISASSEMBLE_OPERATOR_NUMERIC(SUBTRACT, INT, -);
+				DISASSEMBLE_OPERATOR_NUMERIC(MULTIPLY, INT, *);
+				DISASSEMBLE_OPERATOR_NUMERIC(ADD, FLOAT, +);
+				DISASSEMBLE_OPERATOR_NUMERIC(SUBTRACT, FLOAT, -);
+				DISASSEMBLE_OPERATOR_NUMERIC(MULTIPLY, FLOAT, *);
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -267,7 +287,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -288,7 +308,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -374,6 +394,25 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 2;
 			} break;
+
+#define DISASSEMBLE_ASSIGN_UNBOXED(m_v_type) \
+	case OPCODE_ASSIGN_##m_v_type: {         \
+		text += "assign (";                  \
+		text += #m_v_type;                   \
+		text += ") ";                        \
+		text += DADDR(1);                    \
+		text += " = ";                       \
+		text += DADDR(2);                    \
+		incr += 3;                           \
+	} break
+
+				DISASSEMBLE_ASSIGN_UNBOXED(BOOL);
+				DISASSEMBLE_ASSIGN_UNBOXED(INT);
+				DISASSEMBLE_ASSIGN_UNBOXED(FLOAT);
+				DISASSEMBLE_ASSIGN_UNBOXED(VECTOR2);
+				DISASSEMBLE_ASSIGN_UNBOXED(VECTOR2I);
+				DISASSEMBLE_ASSIGN_UNBOXED(VECTOR3);
+				DISASSEMBLE_ASSIGN_UNBOXED(VECTOR3I);
 			case OPCODE_ASSIGN_TYPED_BUILTIN: {
 				text += "assign typed builtin (";
 				text += Variant::get_type_name((Variant::Type)_code_ptr[ip + 3]);
@@ -907,6 +946,21 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+			case OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED: {
+				text += "jump-if-not validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr = 6;
+			} break;
 			case OPCODE_RETURN: {
 				text += "return ";
 				text += DADDR(1);
@@ -104,6 +104,175 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+SafeNumeric<uint64_t> GDScriptFunction::named_access_epoch;
+
+GDScriptFunction::NamedAccessEntry *GDScriptFunction::_find_named_access(NamedAccessSite &p_site, const StringName &p_native_class, const GDScript *p_script, uint64_t p_epoch) const {
+	return p_site.find(p_epoch, [&](const NamedAccessEntry &p_entry) {
+		return p_entry.script == p_script && (p_script || p_entry.native_class == p_native_class);
+	});
+}
+
+void GDScriptFunction::_add_named_access(NamedAccessSite &p_site, const NamedAccessEntry &p_entry) {
+	p_site.add(p_entry, [&](const NamedAccessEntry &p_other) {
+		return p_other.script == p_entry.script && (p_entry.script || p_other.native_class == p_entry.native_class);
+	});
+}
+
+bool GDScriptFunction::_get_named_cached(int p_site, Object *p_object, const StringName &p_name, Variant *r_ret) {
+	NamedAccessSite &site = _named_access_sites[p_site];
+	uint64_t epoch = named_access_epoch.get();
+
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (script_instance) {
+		// Non-tool scripts get a placeholder instance in the editor, which also reports GDScript as its language.
+		if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+			return false;
+		}
+		GDScriptInstance *instance = static_cast<GDScriptInstance *>(script_instance);
+		const GDScript *script = instance->script.ptr();
+
+		NamedAccessEntry *entry = _find_named_access(site, StringName(), script, epoch);
+		int index;
+		if (entry) {
+			index = entry->member_index;
+		} else {
+			// Only plain member variables, everything else is rare enough to go through GDScriptInstance::get().
+			HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+			if (!E || E->value.getter) {
+				return false;
+			}
+			index = E->value.index;
+
+			NamedAccessEntry new_entry;
+			new_entry.script = script;
+			new_entry.epoch = epoch;
+			new_entry.member_index = index;
+			_add_named_access(site, new_entry);
+		}
+
+		if (unlikely(index < 0 || index >= instance->members.size())) {
+			return false;
+		}
+		*r_ret = instance->members[index];
+		return true;
+	}
+
+	const StringName &class_name = p_object->get_class_name();
+	NamedAccessEntry *entry = _find_named_access(site, class_name, nullptr, epoch);
+	MethodBind *getter;
+	if (entry) {
+		getter = entry->method;
+	} else {
+		// Extensions can intercept properties before ClassDB gets to see them, leave those to Object::get().
+		ClassDB::APIType api = ClassDB::get_api_type(class_name);
+		if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+			return false;
+		}
+		bool valid = false;
+		if (ClassDB::get_property_index(class_name, p_name, &valid) != -1 || !valid) {
+			return false;
+		}
+		getter = ClassDB::get_method(class_name, ClassDB::get_property_getter(class_name, p_name));
+		if (!getter) {
+			return false;
+		}
+
+		NamedAccessEntry new_entry;
+		new_entry.native_class = class_name;
+		new_entry.epoch = epoch;
+		new_entry.method = getter;
+		_add_named_access(site, new_entry);
+	}
+
+	Callable::CallError ce;
+	*r_ret = getter->call(p_object, nullptr, 0, ce);
+	return true;
+}
+
+bool GDScriptFunction::_set_named_cached(int p_site, Object *p_object, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+#ifdef TOOLS_ENABLED
+	// Object::set() also marks the object as edited, which can't be done from here.
+	// Once it's marked, setting it again changes nothing, so the cache can be used.
+	if (!p_object->is_edited()) {
+		return false;
+	}
+#endif
+	NamedAccessSite &site = _named_access_sites[p_site];
+	uint64_t epoch = named_access_epoch.get();
+
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (script_instance) {
+		// Non-tool scripts get a placeholder instance in the editor, which also reports GDScript as its language.
+		if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+			return false;
+		}
+		GDScriptInstance *instance = static_cast<GDScriptInstance *>(script_instance);
+		const GDScript *script = instance->script.ptr();
+
+		NamedAccessEntry *entry = _find_named_access(site, StringName(), script, epoch);
+		int index;
+		const GDScriptDataType *type;
+		if (entry) {
+			index = entry->member_index;
+			type = entry->member_type;
+		} else {
+			HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+			if (!E || E->value.setter) {
+				return false;
+			}
+			index = E->value.index;
+			type = &E->value.data_type;
+
+			NamedAccessEntry new_entry;
+			new_entry.script = script;
+			new_entry.epoch = epoch;
+			new_entry.member_index = index;
+			new_entry.member_type = type;
+			_add_named_access(site, new_entry);
+		}
+
+		// Values needing a conversion are left to GDScriptInstance::set().
+		if (unlikely(index < 0 || index >= instance->members.size() || !type->is_type(p_value))) {
+			return false;
+		}
+		instance->members.write[index] = p_value;
+		r_valid = true;
+		return true;
+	}
+
+	const StringName &class_name = p_object->get_class_name();
+	NamedAccessEntry *entry = _find_named_access(site, class_name, nullptr, epoch);
+	MethodBind *setter;
+	if (entry) {
+		setter = entry->method;
+	} else {
+		ClassDB::APIType api = ClassDB::get_api_type(class_name);
+		if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+			return false;
+		}
+		bool valid = false;
+		if (ClassDB::get_property_index(class_name, p_name, &valid) != -1 || !valid) {
+			return false;
+		}
+		setter = ClassDB::get_method(class_name, ClassDB::get_property_setter(class_name, p_name));
+		if (!setter) {
+			return false;
+		}
+
+		NamedAccessEntry new_entry;
+		new_entry.native_class = class_name;
+		new_entry.epoch = epoch;
+		new_entry.method = setter;
+		_add_named_access(site, new_entry);
+	}
+
+	Callable::CallError ce;
+	const Variant *arg = &p_value;
+	setter->call(p_object, &arg, 1, ce);
+	r_valid = ce.error == Callable::CallError::CALL_OK;
+	return true;
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -121,6 +290,10 @@ GDScriptFunction::~GDScriptFunction() {
 		memdelete(lambdas[i]);
 	}
 
+	if (_named_access_sites) {
+		memdelete_arr(_named_access_sites);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
@@ -134,6 +307,69 @@ GDScriptFunction::~GDScriptFunction() {
 
 /////////////////////
 
+SpinLock GDScriptFunctionState::frame_pool_lock;
+LocalVector<uint8_t *> GDScriptFunctionState::frame_pool[FRAME_POOL_CLASSES];
+uint32_t GDScriptFunctionState::frame_pool_bytes = 0;
+
+int GDScriptFunctionState::_get_frame_class(uint32_t p_size) {
+	int frame_class = 0;
+	while ((1u << (frame_class + FRAME_POOL_MIN_SHIFT)) < p_size) {
+		frame_class++;
+	}
+	return frame_class < FRAME_POOL_CLASSES ? frame_class : -1;
+}
+
+uint8_t *GDScriptFunctionState::_alloc_frame(uint32_t p_size) {
+	const int frame_class = _get_frame_class(p_size);
+	if (frame_class < 0) {
+		return (uint8_t *)memalloc(p_size);
+	}
+
+	uint8_t *frame = nullptr;
+	frame_pool_lock.lock();
+	if (!frame_pool[frame_class].is_empty()) {
+		frame = frame_pool[frame_class][frame_pool[frame_class].size() - 1];
+		frame_pool[frame_class].resize(frame_pool[frame_class].size() - 1);
+		frame_pool_bytes -= 1u << (frame_class + FRAME_POOL_MIN_SHIFT);
+	}
+	frame_pool_lock.unlock();
+
+	if (!frame) {
+		frame = (uint8_t *)memalloc(1u << (frame_class + FRAME_POOL_MIN_SHIFT));
+	}
+	return frame;
+}
+
+void GDScriptFunctionState::_free_frame(uint8_t *p_frame, uint32_t p_size) {
+	const int frame_class = _get_frame_class(p_size);
+	if (frame_class >= 0) {
+		frame_pool_lock.lock();
+		const uint32_t frame_size = 1u << (frame_class + FRAME_POOL_MIN_SHIFT);
+		if (frame_pool_bytes + frame_size <= FRAME_POOL_MAX_BYTES) {
+			frame_pool[frame_class].push_back(p_frame);
+			frame_pool_bytes += frame_size;
+			p_frame = nullptr;
+		}
+		frame_pool_lock.unlock();
+	}
+
+	if (p_frame) {
+		memfree(p_frame);
+	}
+}
+
+void GDScriptFunctionState::clear_frame_pool() {
+	frame_pool_lock.lock();
+	for (int i = 0; i < FRAME_POOL_CLASSES; i++) {
+		for (uint8_t *frame : frame_pool[i]) {
+			memfree(frame);
+		}
+		frame_pool[i].reset();
+	}
+	frame_pool_bytes = 0;
+	frame_pool_lock.unlock();
+}
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
@@ -238,26 +474,36 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 		}
 
 #ifdef DEBUG_ENABLED
-		if (EngineDebugger::is_active()) {
+		if (GDScriptLanguage::is_call_stack_tracked()) {
 			GDScriptLanguage::get_singleton()->exit_function();
 		}
-
-		_clear_stack();
 #endif
 	}
 
+	// Gives the frame back. If the function awaited again, it was moved to the new state.
+	_clear_stack();
+
 	return ret;
 }
 
 void GDScriptFunctionState::_clear_stack() {
-	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
-		// The first 3 are special addresses and not copied to the state, so we skip them here.
-		for (int i = 3; i < state.stack_size; i++) {
-			stack[i].~Variant();
-		}
-		state.stack_size = 0;
+	if (!state.stack) {
+		return;
+	}
+
+	// Detach first, destroying the locals may release this state.
+	uint8_t *frame = state.stack;
+	const int stack_size = state.stack_size;
+	const uint32_t frame_size = state.alloca_size;
+	state.stack = nullptr;
+	state.stack_size = 0;
+
+	Variant *stack = (Variant *)frame;
+	// The first 3 are special addresses and not kept in the state, so we skip them here.
+	for (int i = 3; i < stack_size; i++) {
+		stack[i].~Variant();
 	}
+	_free_frame(frame, frame_size);
 }
 
 void GDScriptFunctionState::_clear_connections() {
@@ -288,4 +534,5 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+	_clear_stack();
 }
@@ -31,13 +31,17 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "gdscript_inline_cache.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
@@ -199,6 +203,12 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -220,6 +230,13 @@ public:
 		OPCODE_ASSIGN,
 		OPCODE_ASSIGN_TRUE,
 		OPCODE_ASSIGN_FALSE,
+		OPCODE_ASSIGN_BOOL,
+		OPCODE_ASSIGN_INT,
+		OPCODE_ASSIGN_FLOAT,
+		OPCODE_ASSIGN_VECTOR2,
+		OPCODE_ASSIGN_VECTOR2I,
+		OPCODE_ASSIGN_VECTOR3,
+		OPCODE_ASSIGN_VECTOR3I,
 		OPCODE_ASSIGN_TYPED_BUILTIN,
 		OPCODE_ASSIGN_TYPED_ARRAY,
 		OPCODE_ASSIGN_TYPED_NATIVE,
@@ -255,6 +272,7 @@ public:
 		OPCODE_JUMP_IF_NOT,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
+		OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED,
 		OPCODE_RETURN,
 		OPCODE_RETURN_TYPED_BUILTIN,
 		OPCODE_RETURN_TYPED_ARRAY,
@@ -451,6 +469,36 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Inline caches of OPCODE_GET_NAMED and OPCODE_SET_NAMED, one site per instruction.
+	// They remember how a property was resolved for the last few classes or scripts seen there.
+	enum {
+		NAMED_ACCESS_CACHE_SIZE = 4,
+		NAMED_ACCESS_MAX_MISSES = 32, // Past this the site is considered megamorphic and isn't cached anymore.
+		NAMED_ACCESS_MAX_ALLOCATIONS = 64, // Same, for entries refilled after scripts were compiled or freed.
+	};
+
+	struct NamedAccessEntry {
+		StringName native_class;
+		const GDScript *script = nullptr;
+		uint64_t epoch = 0;
+		MethodBind *method = nullptr;
+		int member_index = -1;
+		const GDScriptDataType *member_type = nullptr;
+		NamedAccessEntry *next_allocated = nullptr;
+	};
+
+	typedef GDScriptInlineCache<NamedAccessEntry, NAMED_ACCESS_CACHE_SIZE, NAMED_ACCESS_MAX_MISSES, NAMED_ACCESS_MAX_ALLOCATIONS> NamedAccessSite;
+
+	static SafeNumeric<uint64_t> named_access_epoch;
+
+	int _named_access_site_count = 0;
+	NamedAccessSite *_named_access_sites = nullptr;
+
+	NamedAccessEntry *_find_named_access(NamedAccessSite &p_site, const StringName &p_native_class, const GDScript *p_script, uint64_t p_epoch) const;
+	void _add_named_access(NamedAccessSite &p_site, const NamedAccessEntry &p_entry);
+	bool _get_named_cached(int p_site, Object *p_object, const StringName &p_name, Variant *r_ret);
+	bool _set_named_cached(int p_site, Object *p_object, const StringName &p_name, const Variant &p_value, bool &r_valid);
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -490,7 +538,7 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // Owned frame, see GDScriptFunctionState.
 		int stack_size = 0;
 		uint32_t alloca_size = 0;
 		int ip = 0;
@@ -506,10 +554,14 @@ public:
 	_FORCE_INLINE_ MethodInfo get_method_info() const { return method_info; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	_FORCE_INLINE_ int get_code_size() const { return _code_size; }
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
 
+	// Must be called whenever the layout of a script's members may have changed.
+	static void invalidate_named_access_caches() { named_access_epoch.increment(); }
+
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
@@ -532,6 +584,20 @@ class GDScriptFunctionState : public RefCounted {
 	SelfList<GDScriptFunctionState> scripts_list;
 	SelfList<GDScriptFunctionState> instances_list;
 
+	// Frames of awaiting functions are recycled, binned by power of two size.
+	enum {
+		FRAME_POOL_MIN_SHIFT = 6,
+		FRAME_POOL_CLASSES = 12,
+		FRAME_POOL_MAX_BYTES = 4 * 1024 * 1024, // Retained by all bins together, frames past this are freed.
+	};
+	static SpinLock frame_pool_lock;
+	static LocalVector<uint8_t *> frame_pool[FRAME_POOL_CLASSES];
+	static uint32_t frame_pool_bytes;
+
+	static int _get_frame_class(uint32_t p_size);
+	static uint8_t *_alloc_frame(uint32_t p_size);
+	static void _free_frame(uint8_t *p_frame, uint32_t p_size);
+
 protected:
 	static void _bind_methods();
 
@@ -542,6 +608,8 @@ public:
 	void _clear_stack();
 	void _clear_connections();
 
+	static void clear_frame_pool();
+
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
 };
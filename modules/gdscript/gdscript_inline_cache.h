@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_INLINE_CACHE_H
+#define GDSCRIPT_INLINE_CACHE_H
+
+#include "core/os/memory.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+// Lock-free cache of the last few lookups done at one place, e.g. one instruction.
+// T must have `uint64_t epoch` and `T *next_allocated` members. Entries from another epoch are ignored.
+// Replaced entries may still be read by other threads, so they are only freed along with the cache,
+// which stops caching anything once it allocated MAX_ALLOCATIONS entries.
+template <typename T, int SIZE, uint32_t MAX_MISSES, uint32_t MAX_ALLOCATIONS>
+class GDScriptInlineCache {
+	std::atomic<T *> entries[SIZE];
+	std::atomic<T *> allocated;
+	SafeNumeric<uint32_t> misses;
+	SafeNumeric<uint32_t> allocations;
+
+public:
+	template <typename Matcher>
+	T *find(uint64_t p_epoch, const Matcher &p_matches) const {
+		for (int i = 0; i < SIZE; i++) {
+			T *entry = entries[i].load(std::memory_order_acquire);
+			if (entry && entry->epoch == p_epoch && p_matches(*entry)) {
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+
+	// `p_matches` tells whether an entry is for the same key as `p_entry`.
+	// Entries only made stale by a new epoch are refilled in place and don't count toward MAX_MISSES,
+	// past which the place is considered megamorphic and nothing new is cached. They count toward MAX_ALLOCATIONS,
+	// as epochs can change any number of times.
+	template <typename Matcher>
+	void add(const T &p_entry, const Matcher &p_matches) {
+		int slot = -1;
+		for (int i = 0; i < SIZE; i++) {
+			T *entry = entries[i].load(std::memory_order_acquire);
+			if (entry && entry->epoch != p_entry.epoch && p_matches(*entry)) {
+				slot = i;
+				break;
+			}
+		}
+		if (slot == -1) {
+			uint32_t miss = misses.increment();
+			if (miss > MAX_MISSES) {
+				return;
+			}
+			slot = (miss - 1) % SIZE;
+		}
+
+		// Checked first, so the count doesn't keep growing once the bound is reached.
+		if (allocations.get() >= MAX_ALLOCATIONS || allocations.increment() > MAX_ALLOCATIONS) {
+			return;
+		}
+
+		T *entry = memnew(T(p_entry));
+		entry->next_allocated = allocated.load(std::memory_order_relaxed);
+		while (!allocated.compare_exchange_weak(entry->next_allocated, entry, std::memory_order_release, std::memory_order_relaxed)) {
+		}
+		entries[slot].store(entry, std::memory_order_release);
+	}
+
+	// Frees every entry and starts over. Only when no other thread can use the cache,
+	// e.g. because the functions the entries point to are being freed too.
+	void clear() {
+		for (int i = 0; i < SIZE; i++) {
+			entries[i].store(nullptr, std::memory_order_relaxed);
+		}
+		T *entry = allocated.exchange(nullptr, std::memory_order_acquire);
+		while (entry) {
+			T *next = entry->next_allocated;
+			memdelete(entry);
+			entry = next;
+		}
+		misses.set(0);
+		allocations.set(0);
+	}
+
+	uint32_t get_allocation_count() const {
+		return MIN(allocations.get(), MAX_ALLOCATIONS);
+	}
+
+	GDScriptInlineCache() {
+		for (int i = 0; i < SIZE; i++) {
+			entries[i].store(nullptr, std::memory_order_relaxed);
+		}
+		allocated.store(nullptr, std::memory_order_relaxed);
+	}
+
+	~GDScriptInlineCache() {
+		clear();
+	}
+};
+
+#endif // GDSCRIPT_INLINE_CACHE_H
@@ -1329,6 +1329,10 @@ private:
 	Node *list = nullptr;
 	List<ParserError> errors;
 
+	// Scripts this one likely needs, collected so the cache can parse them ahead of the analyzer.
+	HashSet<String> dependency_paths;
+	HashSet<StringName> dependency_class_names;
+
 #ifdef DEBUG_ENABLED
 	bool is_ignoring_warnings = false;
 	List<GDScriptWarning> warnings;
@@ -1336,7 +1340,7 @@ private:
 	HashSet<int> unsafe_lines;
 #endif
 
-	GDScriptTokenizer tokenizer;
+	GDScriptTokenizer *tokenizer = nullptr;
 	GDScriptTokenizer::Token previous;
 	GDScriptTokenizer::Token current;
 
@@ -1427,6 +1431,7 @@ private:
 		return node;
 	}
 	void clear();
+	void add_dependency_path(const String &p_path);
 	void push_error(const String &p_message, const Node *p_origin = nullptr);
 #ifdef DEBUG_ENABLED
 	void push_warning(const Node *p_source, GDScriptWarning::Code p_code, const Vector<String> &p_symbols);
@@ -1455,6 +1460,7 @@ private:
 	void pop_multiline();
 
 	// Main blocks.
+	Error parse_token_stream();
 	void parse_program();
 	ClassNode *parse_class(bool p_is_static);
 	void parse_class_name();
@@ -1540,6 +1546,7 @@ private:
 
 public:
 	Error parse(const String &p_source_code, const String &p_script_path, bool p_for_completion);
+	Error parse_binary(const Vector<uint8_t> &p_binary, const String &p_script_path);
 	ClassNode *get_tree() const { return head; }
 	bool is_tool() const { return _is_tool; }
 	ClassNode *find_class(const String &p_qualified_name) const;
@@ -1552,6 +1559,8 @@ public:
 	bool annotation_exists(const String &p_annotation_name) const;
 
 	const List<ParserError> &get_errors() const { return errors; }
+	const HashSet<String> &get_dependency_paths() const { return dependency_paths; }
+	const HashSet<StringName> &get_dependency_class_names() const { return dependency_class_names; }
 	const List<String> get_dependencies() const {
 		// TODO: Keep track of deps.
 		return List<String>();
@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+std::atomic<GDScriptSamplingProfiler *> GDScriptSamplingProfiler::singleton(nullptr);
+std::atomic<uint32_t> GDScriptSamplingProfiler::samples_in_progress(0);
+std::atomic<uint64_t> GDScriptSamplingProfiler::ticks(0);
+thread_local uint64_t GDScriptSamplingProfiler::sampled_ticks = 0;
+
+void GDScriptSamplingProfiler::handle_cmdline() {
+	String output_path;
+	uint64_t interval_usec = 1000;
+
+	List<String> cmdline_args = OS::get_singleton()->get_cmdline_args();
+	for (List<String>::Element *E = cmdline_args.front(); E; E = E->next()) {
+		if (E->get() == "--gdscript-sampling-profiler") {
+			ERR_FAIL_COND_MSG(!E->next(), "Missing <path> argument for --gdscript-sampling-profiler <path>.");
+			output_path = E->next()->get();
+			E = E->next();
+		} else if (E->get() == "--gdscript-sampling-interval") {
+			ERR_FAIL_COND_MSG(!E->next(), "Missing <usec> argument for --gdscript-sampling-interval <usec>.");
+			interval_usec = MAX(E->next()->get().to_int(), 50);
+			E = E->next();
+		}
+	}
+
+	if (output_path.is_empty()) {
+		return;
+	}
+
+#ifdef DEBUG_ENABLED
+	GDScriptSamplingProfiler *profiler = memnew(GDScriptSamplingProfiler(output_path, interval_usec));
+	profiler->start();
+#else
+	WARN_PRINT("The GDScript sampling profiler needs line information, which is only compiled in debug builds. Ignoring --gdscript-sampling-profiler.");
+#endif
+}
+
+void GDScriptSamplingProfiler::_timer_thread_func(void *p_userdata) {
+	GDScriptSamplingProfiler *profiler = static_cast<GDScriptSamplingProfiler *>(p_userdata);
+	while (!profiler->exit_requested.is_set()) {
+		OS::get_singleton()->delay_usec(profiler->interval_usec);
+		ticks.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void GDScriptSamplingProfiler::discard_pending_samples() {
+	sampled_ticks = ticks.load(std::memory_order_relaxed);
+}
+
+void GDScriptSamplingProfiler::take_sample() {
+	if (!is_running()) {
+		// Ticked before the profiler was freed.
+		discard_pending_samples();
+		return;
+	}
+
+	// Samples requested while the thread was in native code called from the script are
+	// all attributed to the line that made the call, which is the line just finished.
+	uint64_t now = ticks.load(std::memory_order_relaxed);
+	uint64_t samples = now - sampled_ticks;
+	sampled_ticks = now;
+	if (samples == 0) {
+		return;
+	}
+
+	String stack;
+	if (Thread::get_caller_id() != Thread::get_main_id()) {
+		stack = "thread";
+	} else if (Engine::get_singleton()->is_in_physics_frame()) {
+		stack = "physics";
+	} else {
+		stack = "process";
+	}
+
+	const GDScriptLanguage::CallStack &call_stack = GDScriptLanguage::_call_stack;
+	for (int i = 0; i < call_stack.stack_pos; i++) {
+		const GDScriptLanguage::CallLevel &level = call_stack.levels[i];
+		if (!level.function) {
+			continue;
+		}
+		stack += ";" + String(level.function->get_source()) + ":" + String(level.function->get_name()) + ":" + itos(level.line ? *level.line : 0);
+	}
+
+	// Marked in progress before checking the profiler again, so it can't be freed meanwhile (see the destructor).
+	samples_in_progress.fetch_add(1);
+	GDScriptSamplingProfiler *profiler = singleton.load();
+	if (profiler) {
+		MutexLock lock(profiler->mutex);
+		HashMap<String, uint64_t>::Iterator E = profiler->folded_stacks.find(stack);
+		if (E) {
+			E->value += samples;
+		} else {
+			profiler->folded_stacks.insert(stack, samples);
+		}
+		profiler->total_samples += samples;
+	}
+	samples_in_progress.fetch_sub(1);
+}
+
+Error GDScriptSamplingProfiler::_write_output() const {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open file '%s' to write the GDScript sampling profile.", output_path));
+
+	for (const KeyValue<String, uint64_t> &E : folded_stacks) {
+		f->store_line(E.key + " " + itos(E.value));
+	}
+	return OK;
+}
+
+void GDScriptSamplingProfiler::start() {
+	// Samples need the call stack, which is only kept up to this depth.
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	if (language->_debug_max_call_stack == 0) {
+		language->_debug_max_call_stack = GLOBAL_GET("debug/settings/gdscript/max_call_stack");
+	}
+
+	exit_requested.clear();
+	timer_thread.start(_timer_thread_func, this);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!timer_thread.is_started()) {
+		return;
+	}
+	exit_requested.set();
+	timer_thread.wait_to_finish();
+
+	MutexLock lock(mutex);
+	if (_write_output() == OK) {
+		print_line(vformat("GDScript sampling profiler: %d samples written to '%s'.", total_samples, output_path));
+	}
+}
+
+GDScriptSamplingProfiler::GDScriptSamplingProfiler(const String &p_output_path, uint64_t p_interval_usec) {
+	GDScriptSamplingProfiler *expected = nullptr;
+	ERR_FAIL_COND(!singleton.compare_exchange_strong(expected, this));
+	output_path = p_output_path;
+	interval_usec = p_interval_usec;
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	// No more ticks once the timer thread is joined, but other threads may still record the samples they had pending.
+	stop();
+
+	GDScriptSamplingProfiler *expected = this;
+	if (!singleton.compare_exchange_strong(expected, nullptr)) {
+		return;
+	}
+	// Samples marked in progress after this see no profiler.
+	while (samples_in_progress.load() != 0) {
+		OS::get_singleton()->delay_usec(1);
+	}
+}
@@ -0,0 +1,83 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+// Statistical profiler for GDScript, enabled with `--gdscript-sampling-profiler <path>`.
+// A timer thread ticks at a fixed interval, and each thread running GDScript takes one
+// sample per tick at its next line boundary, recording its call stack in the folded format
+// used by flamegraph tools.
+class GDScriptSamplingProfiler {
+	// Read by every thread running scripts, while the main thread may free the profiler.
+	// Samples are recorded between marking themselves in progress and unmarking, so it waits for them.
+	static std::atomic<GDScriptSamplingProfiler *> singleton;
+	static std::atomic<uint32_t> samples_in_progress;
+	static std::atomic<uint64_t> ticks;
+	static thread_local uint64_t sampled_ticks; // Ticks already sampled or discarded by this thread.
+
+	String output_path;
+	uint64_t interval_usec = 1000;
+
+	Thread timer_thread;
+	SafeFlag exit_requested;
+
+	Mutex mutex;
+	HashMap<String, uint64_t> folded_stacks;
+	uint64_t total_samples = 0;
+
+	static void _timer_thread_func(void *p_userdata);
+	Error _write_output() const;
+
+public:
+	static GDScriptSamplingProfiler *get_singleton() { return singleton.load(); }
+	_FORCE_INLINE_ static bool is_running() { return singleton.load(std::memory_order_relaxed) != nullptr; }
+	_FORCE_INLINE_ static bool is_sample_pending() { return ticks.load(std::memory_order_relaxed) != sampled_ticks; }
+
+	static void handle_cmdline();
+	static void discard_pending_samples();
+	static void take_sample();
+
+	void start();
+	void stop();
+
+	GDScriptSamplingProfiler(const String &p_output_path, uint64_t p_interval_usec);
+	~GDScriptSamplingProfiler();
+};
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
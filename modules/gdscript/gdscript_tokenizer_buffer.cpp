@@ -0,0 +1,340 @@
+/**************************************************************************/
+/*  gdscript_tokenizer_buffer.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_tokenizer_buffer.h"
+
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+
+static void _append_uint32(Vector<uint8_t> &r_buffer, uint32_t p_value) {
+	int pos = r_buffer.size();
+	r_buffer.resize(pos + 4);
+	encode_uint32(p_value, &r_buffer.write[pos]);
+}
+
+static bool _read_uint32(const Vector<uint8_t> &p_buffer, int &r_pos, uint32_t &r_value) {
+	if (r_pos + 4 > p_buffer.size()) {
+		return false;
+	}
+	r_value = decode_uint32(&p_buffer[r_pos]);
+	r_pos += 4;
+	return true;
+}
+
+Vector<uint8_t> GDScriptTokenizerBuffer::parse_code_string(const String &p_code, CompressMode p_compress_mode) {
+	GDScriptTokenizerText tokenizer;
+	tokenizer.set_source_code(p_code);
+
+	Vector<Token> source_tokens;
+	for (Token token = tokenizer.scan(); token.type != Token::TK_EOF; token = tokenizer.scan()) {
+		ERR_FAIL_COND_V_MSG(token.type == Token::ERROR, Vector<uint8_t>(), vformat("Cannot convert the script to binary tokens, line %d: %s", token.start_line, token.literal));
+		// Whitespace tokens are rebuilt from the token positions when loading.
+		if (token.type == Token::NEWLINE || token.type == Token::INDENT || token.type == Token::DEDENT) {
+			continue;
+		}
+		source_tokens.push_back(token);
+	}
+
+	HashSet<int> continuation_lines;
+	for (int line : tokenizer.get_continuation_lines()) {
+		continuation_lines.insert(line);
+	}
+
+	HashMap<StringName, uint32_t> identifier_map;
+	HashMap<Variant, uint32_t, VariantHasher, VariantComparator> constant_map;
+	Vector<StringName> identifier_list;
+	Vector<Variant> constant_list;
+	Vector<uint8_t> token_data;
+
+	for (int i = 0; i < source_tokens.size(); i++) {
+		const Token &token = source_tokens[i];
+		uint32_t word = token.type;
+
+		if (i == 0 || (token.start_line > source_tokens[i - 1].end_line && !continuation_lines.has(source_tokens[i - 1].end_line))) {
+			word |= TOKEN_LINE_START;
+		}
+
+		if (token.type == Token::LITERAL || token.type == Token::ANNOTATION) {
+			if (!constant_map.has(token.literal)) {
+				constant_map[token.literal] = constant_list.size();
+				constant_list.push_back(token.literal);
+			}
+			word |= constant_map[token.literal] << TOKEN_INDEX_SHIFT;
+		} else if (token.is_node_name()) {
+			// Keywords can be used as identifiers in some places, keep their spelling as well.
+			StringName identifier = token.get_identifier();
+			if (!identifier_map.has(identifier)) {
+				identifier_map[identifier] = identifier_list.size();
+				identifier_list.push_back(identifier);
+			}
+			word |= identifier_map[identifier] << TOKEN_INDEX_SHIFT;
+		}
+
+		_append_uint32(token_data, word);
+		_append_uint32(token_data, token.start_line);
+		_append_uint32(token_data, token.end_line);
+		_append_uint32(token_data, token.start_column);
+		_append_uint32(token_data, token.end_column);
+	}
+
+	Vector<uint8_t> contents;
+	_append_uint32(contents, identifier_list.size());
+	_append_uint32(contents, constant_list.size());
+	_append_uint32(contents, source_tokens.size());
+
+	for (const StringName &identifier : identifier_list) {
+		CharString utf8 = String(identifier).utf8();
+		_append_uint32(contents, utf8.length());
+		int pos = contents.size();
+		contents.resize(pos + utf8.length());
+		memcpy(contents.ptrw() + pos, utf8.get_data(), utf8.length());
+	}
+
+	for (const Variant &constant : constant_list) {
+		int len = 0;
+		Error err = encode_variant(constant, nullptr, len);
+		ERR_FAIL_COND_V_MSG(err != OK, Vector<uint8_t>(), "Cannot encode a script constant to binary tokens.");
+		_append_uint32(contents, len);
+		int pos = contents.size();
+		contents.resize(pos + len);
+		encode_variant(constant, contents.ptrw() + pos, len);
+	}
+
+	contents.append_array(token_data);
+
+	Vector<uint8_t> buffer;
+	buffer.resize(HEADER_SIZE);
+
+	switch (p_compress_mode) {
+		case COMPRESS_NONE: {
+			buffer.append_array(contents);
+			encode_uint32(0, buffer.ptrw() + 12);
+		} break;
+		case COMPRESS_ZSTD: {
+			buffer.resize(HEADER_SIZE + Compression::get_max_compressed_buffer_size(contents.size(), Compression::MODE_ZSTD));
+			int compressed_size = Compression::compress(buffer.ptrw() + HEADER_SIZE, contents.ptr(), contents.size(), Compression::MODE_ZSTD);
+			ERR_FAIL_COND_V_MSG(compressed_size < 0, Vector<uint8_t>(), "Cannot compress the binary tokens of the script.");
+			buffer.resize(HEADER_SIZE + compressed_size);
+			encode_uint32(contents.size(), buffer.ptrw() + 12);
+		} break;
+	}
+
+	uint8_t *header = buffer.ptrw();
+	memcpy(header, "GDSC", 4);
+	encode_uint32(TOKENIZER_VERSION, header + 4);
+	encode_uint32(Token::TK_MAX, header + 8);
+
+	return buffer;
+}
+
+bool GDScriptTokenizerBuffer::is_compatible(const Vector<uint8_t> &p_buffer) {
+	if (p_buffer.size() < HEADER_SIZE) {
+		return false;
+	}
+	const uint8_t *header = p_buffer.ptr();
+	return memcmp(header, "GDSC", 4) == 0 && decode_uint32(header + 4) == TOKENIZER_VERSION && decode_uint32(header + 8) == Token::TK_MAX;
+}
+
+Error GDScriptTokenizerBuffer::set_code_buffer(const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V_MSG(!is_compatible(p_buffer), ERR_FILE_UNRECOGNIZED, "Binary GDScript tokens are invalid or were made by a different engine version.");
+
+	Vector<uint8_t> contents;
+	uint32_t decompressed_size = decode_uint32(p_buffer.ptr() + 12);
+	if (decompressed_size == 0) {
+		contents = p_buffer.slice(HEADER_SIZE);
+	} else {
+		contents.resize(decompressed_size);
+		int result = Compression::decompress(contents.ptrw(), contents.size(), p_buffer.ptr() + HEADER_SIZE, p_buffer.size() - HEADER_SIZE, Compression::MODE_ZSTD);
+		ERR_FAIL_COND_V_MSG(result != (int)decompressed_size, ERR_FILE_CORRUPT, "Cannot decompress binary GDScript tokens.");
+	}
+
+	int pos = 0;
+	uint32_t identifier_count = 0, constant_count = 0, token_count = 0;
+	ERR_FAIL_COND_V(!_read_uint32(contents, pos, identifier_count), ERR_FILE_CORRUPT);
+	ERR_FAIL_COND_V(!_read_uint32(contents, pos, constant_count), ERR_FILE_CORRUPT);
+	ERR_FAIL_COND_V(!_read_uint32(contents, pos, token_count), ERR_FILE_CORRUPT);
+
+	identifiers.resize(identifier_count);
+	for (uint32_t i = 0; i < identifier_count; i++) {
+		uint32_t len = 0;
+		ERR_FAIL_COND_V(!_read_uint32(contents, pos, len), ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(pos + (int)len > contents.size(), ERR_FILE_CORRUPT);
+		String identifier;
+		identifier.parse_utf8((const char *)contents.ptr() + pos, len);
+		identifiers.write[i] = identifier;
+		pos += len;
+	}
+
+	constants.resize(constant_count);
+	for (uint32_t i = 0; i < constant_count; i++) {
+		uint32_t len = 0;
+		ERR_FAIL_COND_V(!_read_uint32(contents, pos, len), ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(pos + (int)len > contents.size(), ERR_FILE_CORRUPT);
+		Error err = decode_variant(constants.write[i], contents.ptr() + pos, len);
+		ERR_FAIL_COND_V(err != OK, ERR_FILE_CORRUPT);
+		pos += len;
+	}
+
+	ERR_FAIL_COND_V(pos + (int)token_count * TOKEN_WORDS * 4 != contents.size(), ERR_FILE_CORRUPT);
+	tokens.resize(token_count);
+	line_starts.resize(token_count);
+	for (uint32_t i = 0; i < token_count; i++) {
+		uint32_t word = 0, start_line = 0, end_line = 0, start_column = 0, end_column = 0;
+		_read_uint32(contents, pos, word);
+		_read_uint32(contents, pos, start_line);
+		_read_uint32(contents, pos, end_line);
+		_read_uint32(contents, pos, start_column);
+		_read_uint32(contents, pos, end_column);
+
+		Token token;
+		token.type = (Token::Type)(word & TOKEN_TYPE_MASK);
+		ERR_FAIL_INDEX_V(token.type, Token::TK_MAX, ERR_FILE_CORRUPT);
+		uint32_t index = word >> TOKEN_INDEX_SHIFT;
+
+		if (token.type == Token::LITERAL || token.type == Token::ANNOTATION) {
+			ERR_FAIL_UNSIGNED_INDEX_V(index, constant_count, ERR_FILE_CORRUPT);
+			token.literal = constants[index];
+		} else if (token.is_node_name()) {
+			ERR_FAIL_UNSIGNED_INDEX_V(index, identifier_count, ERR_FILE_CORRUPT);
+			token.source = identifiers[index];
+		} else {
+			token.source = get_token_name(token.type);
+		}
+
+		token.start_line = start_line;
+		token.end_line = end_line;
+		token.start_column = start_column;
+		token.end_column = end_column;
+		token.leftmost_column = start_column;
+		token.rightmost_column = end_column;
+
+		tokens.write[i] = token;
+		line_starts.write[i] = word & TOKEN_LINE_START;
+	}
+
+	current = 0;
+	checked_line_start = -1;
+	finished = false;
+	pending_indents = 0;
+	indent_stack.clear();
+
+	return OK;
+}
+
+void GDScriptTokenizerBuffer::set_multiline_mode(bool p_state) {
+	multiline_mode = p_state;
+}
+
+void GDScriptTokenizerBuffer::push_expression_indented_block() {
+	indent_stack_stack.push_back(indent_stack);
+}
+
+void GDScriptTokenizerBuffer::pop_expression_indented_block() {
+	ERR_FAIL_COND(indent_stack_stack.size() == 0);
+	indent_stack = indent_stack_stack.back()->get();
+	indent_stack_stack.pop_back();
+}
+
+GDScriptTokenizer::Token GDScriptTokenizerBuffer::make_whitespace_token(Token::Type p_type) const {
+	Token token(p_type);
+	if (p_type == Token::NEWLINE && current > 0) {
+		// Newlines belong to the end of the previous line.
+		const Token &previous = tokens[current - 1];
+		token.start_line = previous.end_line;
+		token.start_column = previous.end_column;
+	} else if (current < tokens.size()) {
+		// Indentation belongs to the beginning of the next line.
+		token.start_line = tokens[current].start_line;
+		token.start_column = 1;
+	} else if (current > 0) {
+		token.start_line = tokens[current - 1].end_line + 1;
+		token.start_column = 1;
+	}
+	token.end_line = token.start_line;
+	token.end_column = token.start_column + 1;
+	token.leftmost_column = token.start_column;
+	token.rightmost_column = token.end_column;
+	token.source = get_token_name(p_type);
+	return token;
+}
+
+void GDScriptTokenizerBuffer::check_indent(int p_column) {
+	// Same rules as the text tokenizer, without the error checks already done when the buffer was made.
+	int indent_count = p_column - 1;
+	int previous_indent = indent_stack.is_empty() ? 0 : indent_stack.back()->get();
+
+	if (indent_count > previous_indent) {
+		indent_stack.push_back(indent_count);
+		pending_indents++;
+		return;
+	}
+	while (!indent_stack.is_empty() && indent_stack.back()->get() > indent_count) {
+		indent_stack.pop_back();
+		pending_indents--;
+	}
+}
+
+GDScriptTokenizer::Token GDScriptTokenizerBuffer::scan() {
+	if (pending_indents > 0) {
+		pending_indents--;
+		return make_whitespace_token(Token::INDENT);
+	} else if (pending_indents < 0) {
+		pending_indents++;
+		return make_whitespace_token(Token::DEDENT);
+	}
+
+	if (current >= tokens.size()) {
+		if (finished) {
+			return make_whitespace_token(Token::TK_EOF);
+		}
+		// Close the last line and every open block, like the text tokenizer does at the end of the source.
+		finished = true;
+		pending_indents -= indent_stack.size();
+		indent_stack.clear();
+		if (!multiline_mode && current > 0) {
+			return make_whitespace_token(Token::NEWLINE);
+		}
+		return scan();
+	}
+
+	if (line_starts[current] && checked_line_start != current) {
+		checked_line_start = current;
+		// Don't give whitespace tokens in multiline mode (inside expressions).
+		if (!multiline_mode) {
+			check_indent(tokens[current].start_column);
+			if (current > 0) {
+				return make_whitespace_token(Token::NEWLINE);
+			}
+			return scan();
+		}
+	}
+
+	return tokens[current++];
+}
@@ -0,0 +1,102 @@
+/**************************************************************************/
+/*  gdscript_tokenizer_buffer.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_TOKENIZER_BUFFER_H
+#define GDSCRIPT_TOKENIZER_BUFFER_H
+
+#include "gdscript_tokenizer.h"
+
+// Replays a token stream serialized from GDScriptTokenizerText, so exported
+// games don't have to ship (and scan) the script source code.
+class GDScriptTokenizerBuffer : public GDScriptTokenizer {
+public:
+	enum CompressMode {
+		COMPRESS_NONE,
+		COMPRESS_ZSTD,
+	};
+
+	// Increment when the serialized layout changes. The amount of token types is
+	// stored as well, so changes to Token::Type also invalidate old buffers.
+	static constexpr uint32_t TOKENIZER_VERSION = 1;
+
+private:
+	enum {
+		HEADER_SIZE = 16,
+		TOKEN_WORDS = 5, // Type, flags and table index, start/end line, start/end column.
+		TOKEN_TYPE_MASK = 0xFF,
+		TOKEN_LINE_START = 1 << 8,
+		TOKEN_INDEX_SHIFT = 9,
+	};
+
+	Vector<StringName> identifiers;
+	Vector<Variant> constants;
+	Vector<Token> tokens;
+	Vector<bool> line_starts; // Whether each token begins a logical line.
+
+	int current = 0;
+	int checked_line_start = -1;
+	bool multiline_mode = false;
+	bool finished = false;
+	int pending_indents = 0;
+	List<int> indent_stack;
+	List<List<int>> indent_stack_stack; // For lambdas, which require manipulating the indentation point.
+
+#ifdef TOOLS_ENABLED
+	HashMap<int, CommentData> dummy;
+#endif // TOOLS_ENABLED
+
+	Token make_whitespace_token(Token::Type p_type) const;
+	void check_indent(int p_column);
+
+public:
+	static Vector<uint8_t> parse_code_string(const String &p_code, CompressMode p_compress_mode);
+	static bool is_compatible(const Vector<uint8_t> &p_buffer);
+
+	Error set_code_buffer(const Vector<uint8_t> &p_buffer);
+
+	virtual int get_cursor_line() const override { return 0; }
+	virtual int get_cursor_column() const override { return 0; }
+	virtual void set_cursor_position(int p_line, int p_column) override {}
+	virtual void set_multiline_mode(bool p_state) override;
+	virtual bool is_past_cursor() const override { return false; }
+	virtual void push_expression_indented_block() override; // For lambdas, or blocks inside expressions.
+	virtual void pop_expression_indented_block() override; // For lambdas, or blocks inside expressions.
+	virtual bool is_text() override { return false; }
+
+#ifdef TOOLS_ENABLED
+	virtual const HashMap<int, CommentData> &get_comments() const override {
+		return dummy;
+	}
+#endif // TOOLS_ENABLED
+
+	virtual Token scan() override;
+};
+
+#endif // GDSCRIPT_TOKENIZER_BUFFER_H
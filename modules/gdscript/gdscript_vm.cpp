@@ -191,6 +191,12 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {          \
 		&&OPCODE_OPERATOR,                             \
 		&&OPCODE_OPERATOR_VALIDATED,                   \
+		&&OPCODE_OPERATOR_ADD_INT,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,              \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,              \
 		&&OPCODE_TYPE_TEST_BUILTIN,                    \
 		&&OPCODE_TYPE_TEST_ARRAY,                      \
 		&&OPCODE_TYPE_TEST_NATIVE,                     \
@@ -212,6 +218,13 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_ASSIGN,                               \
 		&&OPCODE_ASSIGN_TRUE,                          \
 		&&OPCODE_ASSIGN_FALSE,                         \
+		&&OPCODE_ASSIGN_BOOL,                          \
+		&&OPCODE_ASSIGN_INT,                           \
+		&&OPCODE_ASSIGN_FLOAT,                         \
+		&&OPCODE_ASSIGN_VECTOR2,                       \
+		&&OPCODE_ASSIGN_VECTOR2I,                      \
+		&&OPCODE_ASSIGN_VECTOR3,                       \
+		&&OPCODE_ASSIGN_VECTOR3I,                      \
 		&&OPCODE_ASSIGN_TYPED_BUILTIN,                 \
 		&&OPCODE_ASSIGN_TYPED_ARRAY,                   \
 		&&OPCODE_ASSIGN_TYPED_NATIVE,                  \
@@ -247,6 +260,7 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP_IF_NOT,                          \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                 \
 		&&OPCODE_JUMP_IF_SHARED,                       \
+		&&OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED,       \
 		&&OPCODE_RETURN,                               \
 		&&OPCODE_RETURN_TYPED_BUILTIN,                 \
 		&&OPCODE_RETURN_TYPED_ARRAY,                   \
@@ -454,6 +468,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	Variant *stack = nullptr;
 	Variant **instruction_args = nullptr;
 	int defarg = 0;
+	bool stack_moved = false; // Locals were handed to a GDScriptFunctionState by `await`.
 
 #ifdef DEBUG_ENABLED
 
@@ -468,11 +483,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -555,7 +570,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #ifdef DEBUG_ENABLED
 
-	if (EngineDebugger::is_active()) {
+	if (GDScriptLanguage::is_call_stack_tracked()) {
 		GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line);
 	}
 
@@ -751,6 +766,24 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_NUMERIC(m_op, m_v_type, m_get, m_symbol)                                       \
+	OPCODE(OPCODE_OPERATOR_##m_op##_##m_v_type) {                                                      \
+		CHECK_SPACE(4);                                                                                \
+		GET_VARIANT_PTR(a, 0);                                                                         \
+		GET_VARIANT_PTR(b, 1);                                                                         \
+		GET_VARIANT_PTR(dst, 2);                                                                       \
+		*VariantInternal::m_get(dst) = *VariantInternal::m_get(a) m_symbol *VariantInternal::m_get(b); \
+		ip += 4;                                                                                       \
+	}                                                                                                  \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_NUMERIC(ADD, INT, get_int, +);
+			OPCODE_OPERATOR_NUMERIC(SUBTRACT, INT, get_int, -);
+			OPCODE_OPERATOR_NUMERIC(MULTIPLY, INT, get_int, *);
+			OPCODE_OPERATOR_NUMERIC(ADD, FLOAT, get_float, +);
+			OPCODE_OPERATOR_NUMERIC(SUBTRACT, FLOAT, get_float, -);
+			OPCODE_OPERATOR_NUMERIC(MULTIPLY, FLOAT, get_float, *);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1042,18 +1075,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
 
 				int indexname = _code_ptr[ip + 3];
+				int site = _code_ptr[ip + 4];
 
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				GD_ERR_BREAK(site < 0 || site >= _named_access_site_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				Object *obj = dst->get_type() == Variant::OBJECT ? dst->get_validated_object() : nullptr;
+				if (!obj || !_set_named_cached(site, obj, *index, *value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1070,7 +1108,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1090,32 +1128,33 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
 
 				int indexname = _code_ptr[ip + 3];
+				int site = _code_ptr[ip + 4];
 
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				GD_ERR_BREAK(site < 0 || site >= _named_access_site_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				Object *obj = src->get_type() == Variant::OBJECT ? src->get_validated_object() : nullptr;
+				Variant ret;
+				if (!obj || !_get_named_cached(site, obj, *index, &ret)) {
+					bool valid;
+					//allow better error message in cases where src and dst are the same stack position
+					ret = src->get_named(*index, valid);
 #ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
-
-#else
-				*dst = src->get_named(*index, valid);
+					if (!valid) {
+						err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
+						OPCODE_BREAK;
+					}
 #endif
-#ifdef DEBUG_ENABLED
-				if (!valid) {
-					err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
-					OPCODE_BREAK;
 				}
 				*dst = ret;
-#endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1244,6 +1283,24 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_ASSIGN_UNBOXED(m_v_type, m_get)                       \
+	OPCODE(OPCODE_ASSIGN_##m_v_type) {                               \
+		CHECK_SPACE(3);                                              \
+		GET_VARIANT_PTR(dst, 0);                                     \
+		GET_VARIANT_PTR(src, 1);                                     \
+		*VariantInternal::m_get(dst) = *VariantInternal::m_get(src); \
+		ip += 3;                                                     \
+	}                                                                \
+	DISPATCH_OPCODE
+
+			OPCODE_ASSIGN_UNBOXED(BOOL, get_bool);
+			OPCODE_ASSIGN_UNBOXED(INT, get_int);
+			OPCODE_ASSIGN_UNBOXED(FLOAT, get_float);
+			OPCODE_ASSIGN_UNBOXED(VECTOR2, get_vector2);
+			OPCODE_ASSIGN_UNBOXED(VECTOR2I, get_vector2i);
+			OPCODE_ASSIGN_UNBOXED(VECTOR3, get_vector3);
+			OPCODE_ASSIGN_UNBOXED(VECTOR3I, get_vector3i);
+
 			OPCODE(OPCODE_ASSIGN_TYPED_BUILTIN) {
 				CHECK_SPACE(4);
 				GET_VARIANT_PTR(dst, 0);
@@ -2256,13 +2313,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-
-					// First 3 stack addresses are special, so we just skip them here.
-					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
-					}
-					gdfs->state.stack_size = _stack_size;
 					gdfs->state.alloca_size = alloca_size;
 					gdfs->state.ip = ip + 2;
 					gdfs->state.line = line;
@@ -2292,6 +2342,21 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						OPCODE_BREAK;
 					}
 
+					if (p_state) {
+						// Already running on a frame from a previous await, hand it over.
+						gdfs->state.stack = p_state->stack;
+						p_state->stack = nullptr;
+						p_state->stack_size = 0;
+					} else {
+						// Variants don't point into themselves, so they can be relocated
+						// to the frame with a plain copy of their bytes.
+						gdfs->state.stack = GDScriptFunctionState::_alloc_frame(alloca_size);
+						// First 3 stack addresses are special, so we just skip them here.
+						memcpy(gdfs->state.stack + sizeof(Variant) * 3, (const void *)&stack[3], sizeof(Variant) * (_stack_size - 3));
+					}
+					gdfs->state.stack_size = _stack_size;
+					stack_moved = true;
+
 #ifdef DEBUG_ENABLED
 					exit_ok = true;
 					awaited = true;
@@ -2444,6 +2509,29 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_RETURN) {
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(r, 0);
@@ -3442,6 +3530,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+				if (unlikely(GDScriptSamplingProfiler::is_sample_pending())) {
+					// Sampled before moving on, so the line that just ran gets the sample.
+					GDScriptSamplingProfiler::take_sample();
+				}
+
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
@@ -3542,14 +3635,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	// If that is the case then we exit the function as normal. Otherwise we postpone it until the last `await` is completed.
 	// This ensures the call stack can be properly shown when using `await`, showing what resumed the function.
 	if (!p_state || awaited) {
-		if (EngineDebugger::is_active()) {
+		if (GDScriptLanguage::is_call_stack_tracked()) {
 			GDScriptLanguage::get_singleton()->exit_function();
 		}
 #endif
 
-		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		// Free stack, except reserved addresses and locals moved by `await`.
+		if (!stack_moved) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
+			if (p_state) {
+				p_state->stack_size = 0;
+			}
 		}
 #ifdef DEBUG_ENABLED
 	}
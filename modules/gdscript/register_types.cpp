@@ -34,6 +34,7 @@
 #include "gdscript_analyzer.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
+#include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
 
 #ifdef TOOLS_ENABLED
@@ -81,21 +82,36 @@ Ref<GDScriptEditorTranslationParserPlugin> gdscript_translation_parser_plugin;
 class EditorExportGDScript : public EditorExportPlugin {
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	enum ScriptExportMode {
+		EXPORT_TEXT,
+		EXPORT_BINARY_TOKENS,
+		EXPORT_BINARY_TOKENS_COMPRESSED,
+	};
+
 public:
-	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
-		String script_key;
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::INT, "gdscript/export_mode", PROPERTY_HINT_ENUM, "Text,Binary tokens,Compressed binary tokens"), EXPORT_BINARY_TOKENS_COMPRESSED));
+	}
 
-		const Ref<EditorExportPreset> &preset = get_export_preset();
+	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
+		if (!p_path.ends_with(".gd")) {
+			return;
+		}
 
-		if (preset.is_valid()) {
-			script_key = preset->get_script_encryption_key().to_lower();
+		int export_mode = get_option("gdscript/export_mode");
+		if (export_mode == EXPORT_TEXT) {
+			return;
 		}
 
-		if (!p_path.ends_with(".gd")) {
+		// Tokenize the script now, so the exported game skips scanning the source code.
+		const String source = FileAccess::get_file_as_string(p_path);
+		const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(source, export_mode == EXPORT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE);
+		if (tokens.is_empty()) {
+			// Keep the source code, so the error is reported when the script is loaded.
 			return;
 		}
 
-		return;
+		add_file(p_path.get_basename() + ".gdc", tokens, true);
 	}
 
 	virtual String get_name() const override { return "GDScript"; }
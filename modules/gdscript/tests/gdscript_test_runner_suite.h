@@ -33,6 +33,21 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_inline_cache.h"
+#include "../gdscript_parser.h"
+#include "../gdscript_tokenizer_buffer.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_importer.h"
+#include "core/io/resource_loader.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+#ifdef TOOLS_ENABLED
+#include "editor/import/resource_importer_image.h"
+#endif
+
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -71,6 +86,377 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Load binary tokens and run them") {
+	const String source = R"(
+extends RefCounted
+
+const GREETING = """multi
+line"""
+
+func sum_to(n: int) -> int:
+	var total := 0
+	for i in range(n):
+		if i % 2 == 0:
+			total += i
+		else:
+			total += \
+					i * 2
+	return total
+
+func _init():
+	var values := [1, 2, 3].map(func(x):
+		return x * 10
+	)
+	var text := "abc"
+	set_meta("result", [sum_to(5), values, GREETING, text.match("a*")])
+)";
+	Array values;
+	values.push_back(10);
+	values.push_back(20);
+	values.push_back(30);
+	Array expected;
+	expected.push_back(14);
+	expected.push_back(values);
+	expected.push_back("multi\nline");
+	expected.push_back(true);
+
+	for (int compress_mode = GDScriptTokenizerBuffer::COMPRESS_NONE; compress_mode <= GDScriptTokenizerBuffer::COMPRESS_ZSTD; compress_mode++) {
+		const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(source, (GDScriptTokenizerBuffer::CompressMode)compress_mode);
+		REQUIRE_MESSAGE(GDScriptTokenizerBuffer::is_compatible(tokens), "The source code should be converted to binary tokens.");
+
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_binary_tokens_source(tokens);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(error == OK, "The binary tokens should parse successfully.");
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		CHECK_MESSAGE(Array(ref_counted->get_meta("result")) == expected, "The script loaded from binary tokens should behave like its source code.");
+	}
+
+	ERR_PRINT_OFF;
+	const Vector<uint8_t> invalid_tokens = GDScriptTokenizerBuffer::parse_code_string("var a = \"b\n", GDScriptTokenizerBuffer::COMPRESS_NONE);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(invalid_tokens.is_empty(), "Source code with tokenizer errors should not be converted.");
+}
+
+TEST_CASE("[Modules][GDScript] Parser collects script dependencies") {
+	GDScriptParser parser;
+	const Error error = parser.parse(R"(
+extends "../base.gd"
+
+const Helper = preload("helper.gd")
+const Icon = preload("res://icon.svg")
+
+var item: InventoryItem
+)",
+			"res://scripts/player.gd", false);
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	const HashSet<String> &paths = parser.get_dependency_paths();
+	CHECK(paths.size() == 2);
+	CHECK_MESSAGE(paths.has("res://base.gd"), "Relative `extends` paths should be resolved from the script directory.");
+	CHECK_MESSAGE(paths.has("res://scripts/helper.gd"), "Relative `preload` paths should be resolved from the script directory.");
+	CHECK_MESSAGE(parser.get_dependency_class_names().has("InventoryItem"), "Type names should be collected as possible global classes.");
+}
+
+#ifdef TOOLS_ENABLED
+TEST_CASE("[Modules][GDScript] Cached property access skips placeholder instances") {
+	Ref<GDScript> placeholder_script = memnew(GDScript);
+	placeholder_script->set_source_code(R"(
+extends Object
+
+@export var value := 1
+)");
+	ERR_PRINT_OFF;
+	Error error = placeholder_script->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The placeholder script should compile successfully.");
+
+	Ref<GDScript> accessor_script = memnew(GDScript);
+	accessor_script->set_source_code(R"(
+extends RefCounted
+
+func write(object):
+	object.value = 5
+
+func read(object):
+	return object.value
+)");
+	ERR_PRINT_OFF;
+	error = accessor_script->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The accessor script should compile successfully.");
+
+	// What the editor gives to nodes with non-tool scripts.
+	Object *object = memnew(Object);
+	object->set_script_instance(placeholder_script->placeholder_instance_create(object));
+
+	Ref<RefCounted> accessor = memnew(RefCounted);
+	accessor->set_script(accessor_script);
+	// Run twice, so the second time goes through the cache.
+	for (int i = 0; i < 2; i++) {
+		accessor->call("write", object);
+		CHECK_MESSAGE(int(accessor->call("read", object)) == 5, "Properties of placeholder instances should be accessed through the placeholder.");
+	}
+
+	memdelete(object);
+}
+#endif // TOOLS_ENABLED
+
+struct InlineCacheTestEntry {
+	int key = 0;
+	uint64_t epoch = 0;
+	InlineCacheTestEntry *next_allocated = nullptr;
+};
+
+TEST_CASE("[Modules][GDScript] Inline caches stop allocating past their bound") {
+	GDScriptInlineCache<InlineCacheTestEntry, 4, 32, 64> cache;
+	const auto matches = [](const InlineCacheTestEntry &p_entry) {
+		return p_entry.key == 1;
+	};
+
+	// The same key is looked up after every epoch change, like a property read between script compilations.
+	// Each time the stale entry is replaced, which doesn't count as a miss, but allocates.
+	bool cached_before_bound = true;
+	bool cached_past_bound = false;
+	for (uint64_t epoch = 1; epoch <= 1000; epoch++) {
+		if (!cache.find(epoch, matches)) {
+			InlineCacheTestEntry entry;
+			entry.key = 1;
+			entry.epoch = epoch;
+			cache.add(entry, matches);
+		}
+		const bool cached = cache.find(epoch, matches) != nullptr;
+		if (epoch <= 64) {
+			cached_before_bound = cached_before_bound && cached;
+		} else {
+			cached_past_bound = cached_past_bound || cached;
+		}
+	}
+	CHECK_MESSAGE(cached_before_bound, "Entries should be refilled after epoch changes until the bound is reached.");
+	CHECK_MESSAGE(!cached_past_bound, "Nothing should be cached anymore past the bound.");
+	CHECK_MESSAGE(cache.get_allocation_count() == 64, "Allocations should stop at the bound.");
+}
+
+TEST_CASE("[Modules][GDScript] Methods called by name follow script reloads") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	const String source = R"(
+extends RefCounted
+
+class Base:
+	func value():
+		return %d
+
+class Derived extends Base:
+	pass
+
+static func make():
+	return Derived.new()
+)";
+	gdscript->set_source_code(vformat(source, 0));
+	ERR_PRINT_OFF;
+	Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Ref<RefCounted> instance = gdscript->call("make");
+	REQUIRE(instance.is_valid());
+	Ref<GDScript> derived_script = instance->get_script();
+	REQUIRE(derived_script.is_valid());
+
+	// More reloads than the cache takes misses or allocations, each one replacing the method inherited by the instance.
+	for (int i = 1; i <= 100; i++) {
+		gdscript->set_source_code(vformat(source, i));
+		ERR_PRINT_OFF;
+		error = gdscript->reload(true);
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The script should reload successfully.");
+		// Run twice, so the second time goes through the cache.
+		CHECK_MESSAGE(int(instance->call("value")) == i, "Calls by name should reach the reloaded method of the base class.");
+		CHECK_MESSAGE(int(instance->call("value")) == i, "Calls by name should reach the reloaded method of the base class.");
+	}
+	CHECK_MESSAGE(derived_script->get_method_cache_allocation_count() <= 1, "Entries should be freed when the script is reloaded.");
+}
+
+static int _get_compiled_function_size(const String &p_source, const StringName &p_function) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+	REQUIRE(gdscript->get_member_functions().has(p_function));
+	return gdscript->get_member_functions()[p_function]->get_code_size();
+}
+
+TEST_CASE("[Modules][GDScript] Constant conditions and builtin calls are folded") {
+	const int folded_size = _get_compiled_function_size(R"(
+const DEBUG = false
+const NAME = "player"
+
+func test():
+	var unused := Vector2(1, 2)
+	if DEBUG:
+		print("debug")
+	while DEBUG:
+		print("loop")
+	return NAME.to_upper().length()
+)",
+			"test");
+	// Same amount of statements, since each one emits a line marker in debug builds.
+	const int reference_size = _get_compiled_function_size(R"(
+func test():
+	pass
+	pass
+	pass
+	return 6
+)",
+			"test");
+	CHECK_MESSAGE(folded_size == reference_size, "Dead branches, unused constant locals and constant builtin method calls should not produce bytecode.");
+
+	const int dynamic_size = _get_compiled_function_size(R"(
+var debug = false
+var name = "player"
+
+func test():
+	var unused := Vector2(1, 2)
+	if debug:
+		print("debug")
+	while debug:
+		print("loop")
+	return name.to_upper().length()
+)",
+			"test");
+	CHECK(folded_size < dynamic_size);
+}
+
+#ifdef TOOLS_ENABLED
+TEST_CASE("[Modules][GDScript] Script-backed loaders and importers keep the project scan serial") {
+	// The editor scans files with script-backed loaders or importers on its own thread, as scripts aren't thread-safe.
+	Ref<GDScript> loader_script = memnew(GDScript);
+	loader_script->set_source_code(R"(
+extends ResourceFormatLoader
+
+func _get_recognized_extensions():
+	return PackedStringArray(["scantest"])
+)");
+	ERR_PRINT_OFF;
+	Error error = loader_script->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The loader script should compile successfully.");
+
+	CHECK_FALSE(ResourceLoader::has_script_loaders());
+	Ref<ResourceFormatLoader> loader;
+	loader.instantiate();
+	loader->set_script(loader_script);
+	ResourceLoader::add_resource_format_loader(loader);
+	CHECK_MESSAGE(ResourceLoader::has_script_loaders(), "Loaders implemented in scripts should be reported.");
+	ResourceLoader::remove_resource_format_loader(loader);
+	CHECK_FALSE(ResourceLoader::has_script_loaders());
+
+	Ref<GDScript> importer_script = memnew(GDScript);
+	importer_script->set_source_code(R"(
+extends RefCounted
+)");
+	ERR_PRINT_OFF;
+	error = importer_script->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The importer script should compile successfully.");
+
+	ResourceFormatImporter *format_importer = ResourceFormatImporter::get_singleton();
+	CHECK_FALSE(format_importer->has_script_importers());
+	Ref<ResourceImporter> importer = memnew(ResourceImporterImage);
+	format_importer->add_importer(importer);
+	CHECK_MESSAGE(!format_importer->has_script_importers(), "Native importers can be scanned on any thread.");
+	importer->set_script(importer_script);
+	CHECK_MESSAGE(format_importer->has_script_importers(), "Importers with a script should be reported.");
+	format_importer->remove_importer(importer);
+	CHECK_FALSE(format_importer->has_script_importers());
+}
+#endif // TOOLS_ENABLED
+
+#ifdef DEBUG_ENABLED
+struct SamplingProfilerBusyThread {
+	Ref<RefCounted> object;
+	SafeFlag done;
+};
+
+static void _sampling_profiler_busy_thread(void *p_userdata) {
+	SamplingProfilerBusyThread *busy = static_cast<SamplingProfilerBusyThread *>(p_userdata);
+	while (!busy->done.is_set()) {
+		busy->object->call("busy");
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler samples each thread separately") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func busy():
+	var total := 0
+	for i in 10000:
+		total += i
+	return total
+
+func idle():
+	return 0
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	const String output_path = OS::get_singleton()->get_cache_path().path_join("gdscript_sampling_profile.txt");
+	GDScriptSamplingProfiler *profiler = memnew(GDScriptSamplingProfiler(output_path, 50));
+	profiler->start();
+
+	SamplingProfilerBusyThread busy;
+	busy.object.instantiate();
+	busy.object->set_script(gdscript);
+	Thread thread;
+	thread.start(_sampling_profiler_busy_thread, &busy);
+
+	// Entering scripts from here discards the samples of this thread, which must not take those of the busy one.
+	Ref<RefCounted> idle = memnew(RefCounted);
+	idle->set_script(gdscript);
+	const uint64_t start = OS::get_singleton()->get_ticks_msec();
+	while (OS::get_singleton()->get_ticks_msec() - start < 200) {
+		idle->call("idle");
+		OS::get_singleton()->delay_usec(100);
+	}
+
+	// Freed while the busy thread keeps running scripts, which must stop sampling.
+	memdelete(profiler);
+	busy.done.set();
+	thread.wait_to_finish();
+
+	Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	uint64_t busy_samples = 0;
+	uint64_t total_samples = 0;
+	while (!f->eof_reached()) {
+		const String line = f->get_line();
+		if (line.is_empty()) {
+			continue;
+		}
+		const uint64_t samples = line.get_slice(" ", line.get_slice_count(" ") - 1).to_int();
+		if (line.begins_with("thread;") && line.contains(":busy:")) {
+			busy_samples += samples;
+		}
+		total_samples += samples;
+	}
+	f.unref();
+	DirAccess::remove_absolute(output_path);
+
+	CHECK_MESSAGE(busy_samples > 0, "The thread running the busy function should get samples.");
+	CHECK_MESSAGE(busy_samples * 2 >= total_samples, "Most samples should land on the busy function.");
+}
+#endif // DEBUG_ENABLED
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
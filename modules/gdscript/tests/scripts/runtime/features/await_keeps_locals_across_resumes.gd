@@ -0,0 +1,27 @@
+signal step(value)
+
+var results := []
+
+func worker(id: int) -> void:
+	var total := id * 100
+	var label := "worker %d" % id
+	var items := [id]
+	for _i in 3:
+		var value = await step
+		total += value
+		items.append(value)
+	results.append([label, total, items])
+
+func test():
+	for id in 3:
+		worker(id)
+	for value in [1, 2, 3]:
+		step.emit(value)
+	for result in results:
+		print(result)
+
+	# Frames given back by finished coroutines are reused.
+	worker(7)
+	for value in [10, 20, 30]:
+		step.emit(value)
+	print(results.back())
@@ -0,0 +1,33 @@
+const ENABLED = true
+const DISABLED = false
+const NAME = "player"
+const POINT = Vector2(3, 4)
+
+func test():
+	var _unused := Vector2(1, 2)
+
+	if DISABLED:
+		print("not printed")
+	elif ENABLED:
+		print("elif taken")
+	else:
+		print("not printed")
+
+	if ENABLED:
+		print("if taken")
+
+	while DISABLED:
+		print("not printed")
+
+	print(NAME.to_upper())
+	print(NAME.length())
+	print(POINT.length())
+	print(Vector2.from_angle(0.0))
+	print(ENABLED if true else DISABLED)
+
+	# Folded packed arrays are still copied on write.
+	var first := NAME.split("a")
+	var second := NAME.split("a")
+	first.append("extra")
+	print(first)
+	print(second)
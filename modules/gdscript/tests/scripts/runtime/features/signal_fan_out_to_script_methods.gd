@@ -0,0 +1,40 @@
+signal value_changed(value: int)
+
+class Receiver:
+	var total := 0
+
+	func on_value_changed(value: int) -> void:
+		total += value
+
+class DoublingReceiver extends Receiver:
+	func on_value_changed(value: int) -> void:
+		total += value * 2
+
+class InheritingReceiver extends Receiver:
+	pass
+
+func test():
+	var receivers := []
+	for i in 300:
+		var receiver: Receiver
+		match i % 3:
+			0:
+				receiver = Receiver.new()
+			1:
+				receiver = DoublingReceiver.new()
+			2:
+				receiver = InheritingReceiver.new()
+		value_changed.connect(receiver.on_value_changed)
+		receivers.append(receiver)
+
+	for value in [1, 2, 3]:
+		value_changed.emit(value)
+
+	# Connections are still plain method callables.
+	value_changed.disconnect(receivers[0].on_value_changed)
+	value_changed.emit(100)
+
+	var totals := {}
+	for receiver in receivers:
+		totals[receiver.total] = totals.get(receiver.total, 0) + 1
+	print(totals)
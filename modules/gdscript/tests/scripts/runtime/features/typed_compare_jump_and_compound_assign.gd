@@ -0,0 +1,54 @@
+func count_below(limit: int) -> int:
+	var i := 0
+	var total := 0
+	while i < limit:
+		if i % 2 == 0 and i != 4:
+			total += i
+		i += 1
+	return total
+
+func test():
+	print(count_below(10))
+
+	var i := 0
+	while i < 20:
+		i += 3
+		if i > 10:
+			break
+	print(i)
+
+	var f := 0.5
+	f *= 4.0
+	f -= 1.0
+	print(f)
+
+	var s := "a"
+	s += "b"
+	s += "c"
+	print(s)
+
+	var v := Vector2(1, 2)
+	v += Vector2(3, 4)
+	v *= 2.0
+	print(v)
+
+	var arr := [1, 2, 3]
+	arr += [4, 5]
+	arr += arr
+	print(arr)
+
+	var n := 7
+	n /= 2
+	n %= 3
+	print(n)
+
+	var x := 5
+	var y := 3
+	if x > y:
+		print("greater")
+	else:
+		print("not greater")
+	if x < y:
+		print("less")
+	else:
+		print("not less")
@@ -0,0 +1,35 @@
+func test():
+	var b := false
+	var i := 1
+	var f := 1.0
+	var v2 := Vector2()
+	var v2i := Vector2i()
+	var v3 := Vector3()
+	var v3i := Vector3i()
+
+	for _n in 3:
+		b = not b
+		i = i * 2
+		f = f * 0.5
+		v2 = v2 + Vector2(1, 1)
+		v2i = v2i + Vector2i(2, 2)
+		v3 = v3 + Vector3(1, 2, 3)
+		v3i = v3i + Vector3i(3, 2, 1)
+
+	print(b)
+	print(i)
+	print(f)
+	print(v2)
+	print(v2i)
+	print(v3)
+	print(v3i)
+
+	# Assigning a different type still converts.
+	var g := 2.5
+	g = i
+	print(g)
+	var h: int = 0
+	var other := i
+	h = other
+	other = 100
+	print(h)
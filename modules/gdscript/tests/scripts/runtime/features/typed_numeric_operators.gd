@@ -0,0 +1,26 @@
+func test():
+	var a := 7
+	var b := -3
+	print(a + b)
+	print(a - b)
+	print(a * b)
+	var c := a * b + a - b
+	print(c)
+
+	var x := 1.5
+	var y := 0.25
+	print(x + y)
+	print(x - y)
+	print(x * y)
+
+	var sum := 0
+	var prod := 1.0
+	for i in 10:
+		sum += i * i
+		prod *= 1.5
+	print(sum)
+	print(prod)
+
+	# Mixed operands still go through the generic evaluators.
+	print(a + x)
+	print(a * y)
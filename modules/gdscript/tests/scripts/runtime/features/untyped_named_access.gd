@@ -0,0 +1,60 @@
+# Untyped property accesses go through per-instruction caches, which must follow the receiver's actual type.
+
+class A:
+	var value = "A"
+	var typed: int = 1
+
+class B:
+	var padding = null
+	var value = "B"
+	var typed: int = 2
+
+class C:
+	var value:
+		get:
+			return "C (getter)"
+		set(v):
+			print("C setter: ", v)
+	var typed: int = 3
+
+class D extends Resource:
+	var value = "D"
+	var typed: int = 4
+
+func get_value(obj):
+	return obj.value
+
+func set_typed(obj, v):
+	obj.typed = v
+
+func test():
+	var objects = [A.new(), B.new(), C.new(), D.new(), A.new(), B.new()]
+	for _i in 2:
+		for obj in objects:
+			print(get_value(obj))
+
+	for obj in objects:
+		set_typed(obj, 5.9) # Needs a conversion.
+		print(obj.typed)
+		set_typed(obj, 7)
+		print(obj.typed)
+
+	var c = C.new()
+	c.value = "x"
+
+	var resources = [Resource.new(), Resource.new(), D.new()]
+	for i in resources.size():
+		resources[i].resource_name = "res %d" % i
+	for res in resources:
+		print(res.resource_name)
+
+	# Again, now through the cached setters.
+	for _i in 2:
+		for i in resources.size():
+			resources[i].resource_name = "again %d" % i
+		for obj in objects:
+			set_typed(obj, 8)
+	for res in resources:
+		print(res.resource_name)
+	for obj in objects:
+		print(obj.typed)
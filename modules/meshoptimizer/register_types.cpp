@@ -34,6 +34,12 @@
 
 #include "thirdparty/meshoptimizer/meshoptimizer.h"
 
+static_assert(sizeof(SurfaceTool::Meshlet) == sizeof(meshopt_Meshlet), "SurfaceTool::Meshlet must match meshopt_Meshlet.");
+
+static size_t _build_meshlets(SurfaceTool::Meshlet *meshlets, unsigned int *meshlet_vertices, unsigned char *meshlet_triangles, const unsigned int *indices, size_t index_count, const float *vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight) {
+	return meshopt_buildMeshlets(reinterpret_cast<meshopt_Meshlet *>(meshlets), meshlet_vertices, meshlet_triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight);
+}
+
 void initialize_meshoptimizer_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
@@ -47,6 +53,9 @@ void initialize_meshoptimizer_module(ModuleInitializationLevel p_level) {
 	SurfaceTool::generate_remap_func = meshopt_generateVertexRemap;
 	SurfaceTool::remap_vertex_func = meshopt_remapVertexBuffer;
 	SurfaceTool::remap_index_func = meshopt_remapIndexBuffer;
+	SurfaceTool::build_meshlets_bound_func = meshopt_buildMeshletsBound;
+	SurfaceTool::build_meshlets_func = _build_meshlets;
+	SurfaceTool::spatial_sort_remap_func = meshopt_spatialSortRemap;
 }
 
 void uninitialize_meshoptimizer_module(ModuleInitializationLevel p_level) {
@@ -61,4 +70,7 @@ void uninitialize_meshoptimizer_module(ModuleInitializationLevel p_level) {
 	SurfaceTool::generate_remap_func = nullptr;
 	SurfaceTool::remap_vertex_func = nullptr;
 	SurfaceTool::remap_index_func = nullptr;
+	SurfaceTool::build_meshlets_bound_func = nullptr;
+	SurfaceTool::build_meshlets_func = nullptr;
+	SurfaceTool::spatial_sort_remap_func = nullptr;
 }
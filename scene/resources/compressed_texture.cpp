@@ -30,9 +30,14 @@
 
 #include "compressed_texture.h"
 
+#include "core/config/project_settings.h"
 #include "scene/resources/bit_map.h"
 
-Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
+Mutex CompressedTexture2D::stream_mutex;
+SelfList<CompressedTexture2D>::List CompressedTexture2D::stream_list;
+uint64_t CompressedTexture2D::stream_memory_usage = 0;
+
+Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, bool &r_streamable, Size2i &r_full_size, int p_size_limit) {
 	alpha_cache.unref();
 
 	ERR_FAIL_COND_V(image.is_null(), ERR_INVALID_PARAMETER);
@@ -75,11 +80,12 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 	r_request_normal = false;
 
 #endif
-	if (!(df & FORMAT_BIT_STREAM)) {
+	r_streamable = df & FORMAT_BIT_STREAM;
+	if (!r_streamable) {
 		p_size_limit = 0;
 	}
 
-	image = load_image_from_file(f, p_size_limit);
+	image = load_image_from_file(f, p_size_limit, &r_full_size);
 
 	if (image.is_null() || image->is_empty()) {
 		return ERR_CANT_OPEN;
@@ -134,8 +140,13 @@ Error CompressedTexture2D::load(const String &p_path) {
 	bool request_normal;
 	bool request_roughness;
 	int mipmap_limit;
+	bool file_streamable;
+	Size2i full_size;
+
+	// Streamable textures start with their low mip levels only.
+	int stream_min_size = GLOBAL_GET("rendering/textures/streaming/min_size");
 
-	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, file_streamable, full_size, stream_min_size);
 	if (err) {
 		return err;
 	}
@@ -154,6 +165,7 @@ Error CompressedTexture2D::load(const String &p_path) {
 	h = lh;
 	path_to_file = p_path;
 	format = image->get_format();
+	_stream_set_resident(image, file_streamable, full_size);
 
 	if (get_path().is_empty()) {
 		//temporarily set path if no path set for resource, helps find errors
@@ -293,16 +305,153 @@ void CompressedTexture2D::reload_from_file() {
 	load(path);
 }
 
+void CompressedTexture2D::_stream_set_resident(const Ref<Image> &p_image, bool p_streamable, const Size2i &p_full_size) {
+	MutexLock lock(stream_mutex);
+
+	stream_memory_usage -= stream_memory;
+	stream_memory = 0;
+	streamable = p_streamable;
+
+	if (!streamable) {
+		stream_size = 0;
+		stream_full_size = 0;
+		if (stream_list_element.in_list()) {
+			stream_list.remove(&stream_list_element);
+		}
+		return;
+	}
+
+	stream_size = MAX(p_image->get_width(), p_image->get_height());
+	stream_full_size = MAX(p_full_size.width, p_full_size.height);
+	stream_memory = p_image->get_data().size();
+	stream_memory_usage += stream_memory;
+
+	if (!stream_list_element.in_list()) {
+		stream_list.add_last(&stream_list_element);
+	}
+}
+
+Error CompressedTexture2D::_stream_reload(int p_size_limit) {
+	int lw, lh;
+	Ref<Image> image;
+	image.instantiate();
+
+	bool request_3d;
+	bool request_normal;
+	bool request_roughness;
+	int mipmap_limit;
+	bool file_streamable;
+	Size2i full_size;
+
+	Error err = _load_data(path_to_file, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, file_streamable, full_size, p_size_limit);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Unable to stream mipmaps from file: %s.", path_to_file));
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	if (lw || lh) {
+		RS::get_singleton()->texture_set_size_override(texture, lw, lh);
+	}
+
+	_stream_set_resident(image, file_streamable, full_size);
+	return OK;
+}
+
+void CompressedTexture2D::_stream_enforce_budget() {
+	uint64_t budget = uint64_t(int(GLOBAL_GET("rendering/textures/streaming/memory_budget_mb"))) * 1024 * 1024;
+	int min_size = GLOBAL_GET("rendering/textures/streaming/min_size");
+
+	// Drop the high mip levels of the least recently requested textures first, one at a time.
+	while (true) {
+		Ref<CompressedTexture2D> victim;
+		{
+			MutexLock lock(stream_mutex);
+			for (SelfList<CompressedTexture2D> *E = stream_list.first(); E && stream_memory_usage > budget; E = E->next()) {
+				CompressedTexture2D *tex = E->self();
+				if (tex == this || tex->stream_loading || tex->stream_size <= min_size) {
+					continue;
+				}
+				// Fails for textures that are already being freed.
+				victim = Ref<CompressedTexture2D>(tex);
+				if (victim.is_valid()) {
+					tex->stream_loading = true;
+					break;
+				}
+			}
+		}
+		if (victim.is_null()) {
+			return;
+		}
+
+		Error err = victim->_stream_reload(min_size);
+		{
+			MutexLock lock(stream_mutex);
+			victim->stream_loading = false;
+		}
+		if (err != OK) {
+			return;
+		}
+	}
+}
+
+void CompressedTexture2D::request_stream_size(int p_size) {
+	int size_limit;
+	{
+		MutexLock lock(stream_mutex);
+
+		if (!streamable) {
+			return;
+		}
+
+		stream_list.remove(&stream_list_element);
+		stream_list.add_last(&stream_list_element);
+
+		if (stream_size >= stream_full_size || stream_size >= p_size || stream_loading) {
+			return; // Already resident, or about to be.
+		}
+		stream_loading = true;
+
+		size_limit = next_power_of_2(p_size);
+		if (size_limit >= stream_full_size) {
+			size_limit = 0;
+		}
+	}
+
+	Error err = _stream_reload(size_limit);
+	{
+		MutexLock lock(stream_mutex);
+		stream_loading = false;
+	}
+	if (err != OK) {
+		return;
+	}
+
+	_stream_enforce_budget();
+}
+
+int CompressedTexture2D::get_stream_size() const {
+	MutexLock lock(stream_mutex);
+	return streamable ? stream_size : MAX(w, h);
+}
+
+uint64_t CompressedTexture2D::get_stream_memory_usage() {
+	MutexLock lock(stream_mutex);
+	return stream_memory_usage;
+}
+
 void CompressedTexture2D::_validate_property(PropertyInfo &p_property) const {
 }
 
-Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_size_limit) {
+Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_size_limit, Size2i *r_full_size) {
 	uint32_t data_format = f->get_32();
 	uint32_t w = f->get_16();
 	uint32_t h = f->get_16();
 	uint32_t mipmaps = f->get_32();
 	Image::Format format = Image::Format(f->get_32());
 
+	if (r_full_size) {
+		*r_full_size = Size2i(w, h);
+	}
+
 	if (data_format == DATA_FORMAT_PNG || data_format == DATA_FORMAT_WEBP) {
 		//look for a PNG or WebP file inside
 
@@ -312,13 +461,15 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 		//mipmaps need to be read independently, they will be later combined
 		Vector<Ref<Image>> mipmap_images;
 		uint64_t total_size = 0;
+		int first_w = 0;
+		int first_h = 0;
 
 		bool first = true;
 
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			uint32_t size = f->get_32();
 
-			if (p_size_limit > 0 && i < (mipmaps - 1) && (sw > p_size_limit || sh > p_size_limit)) {
+			if (p_size_limit > 0 && i < mipmaps && (sw > p_size_limit || sh > p_size_limit)) {
 				//can't load this due to size limit
 				sw = MAX(sw >> 1, 1);
 				sh = MAX(sh >> 1, 1);
@@ -348,6 +499,8 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				//format will actually be the format of the first image,
 				//as it may have changed on compression
 				format = img->get_format();
+				first_w = sw;
+				first_h = sh;
 				first = false;
 			} else if (img->get_format() != format) {
 				img->convert(format); //all needs to be the same format
@@ -389,7 +542,7 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				}
 			}
 
-			image->set_data(w, h, true, mipmap_images[0]->get_format(), img_data);
+			image->set_data(first_w, first_h, true, mipmap_images[0]->get_format(), img_data);
 			return image;
 		}
 
@@ -421,18 +574,19 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 		return img;
 	} else if (data_format == DATA_FORMAT_IMAGE) {
 		int size = Image::get_image_data_size(w, h, format, mipmaps ? true : false);
+		uint64_t data_start = f->get_position();
 
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
-				continue; //oops, size limit enforced, go to next
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
+				continue; // Size limit enforced, skip this mip level.
 			}
 
+			// Only read the mip levels that fit in the size limit.
+			f->seek(data_start + ofs);
+
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
 
@@ -453,13 +607,24 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 void CompressedTexture2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load", "path"), &CompressedTexture2D::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &CompressedTexture2D::get_load_path);
+	ClassDB::bind_method(D_METHOD("request_stream_size", "size"), &CompressedTexture2D::request_stream_size);
+	ClassDB::bind_method(D_METHOD("get_stream_size"), &CompressedTexture2D::get_stream_size);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.ctex"), "load", "get_load_path");
 }
 
-CompressedTexture2D::CompressedTexture2D() {}
+CompressedTexture2D::CompressedTexture2D() :
+		stream_list_element(this) {}
 
 CompressedTexture2D::~CompressedTexture2D() {
+	{
+		MutexLock lock(stream_mutex);
+		if (stream_list_element.in_list()) {
+			stream_list.remove(&stream_list_element);
+		}
+		stream_memory_usage -= stream_memory;
+	}
+
 	if (texture.is_valid()) {
 		ERR_FAIL_NULL(RenderingServer::get_singleton());
 		RS::get_singleton()->free(texture);
@@ -67,9 +67,28 @@ private:
 	int h = 0;
 	mutable Ref<BitMap> alpha_cache;
 
-	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0);
+	// Mip streaming, only used for textures imported as streamable.
+	// Only the mip levels up to stream_size are resident, higher ones
+	// are loaded from the file when requested.
+	bool streamable = false;
+	int stream_size = 0;
+	int stream_full_size = 0;
+	uint64_t stream_memory = 0;
+	bool stream_loading = false; // Mip levels are being read, without holding stream_mutex.
+	SelfList<CompressedTexture2D> stream_list_element;
+
+	// Only guards the streaming bookkeeping, never held while reading files or calling the RenderingServer.
+	static Mutex stream_mutex;
+	static SelfList<CompressedTexture2D>::List stream_list; // Least recently requested first.
+	static uint64_t stream_memory_usage;
+
+	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, bool &r_streamable, Size2i &r_full_size, int p_size_limit = 0);
 	virtual void reload_from_file() override;
 
+	void _stream_set_resident(const Ref<Image> &p_image, bool p_streamable, const Size2i &p_full_size);
+	Error _stream_reload(int p_size_limit);
+	void _stream_enforce_budget();
+
 	static void _requested_3d(void *p_ud);
 	static void _requested_roughness(void *p_ud, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
 	static void _requested_normal(void *p_ud);
@@ -79,7 +98,7 @@ protected:
 	void _validate_property(PropertyInfo &p_property) const;
 
 public:
-	static Ref<Image> load_image_from_file(Ref<FileAccess> p_file, int p_size_limit);
+	static Ref<Image> load_image_from_file(Ref<FileAccess> p_file, int p_size_limit, Size2i *r_full_size = nullptr);
 
 	typedef void (*TextureFormatRequestCallback)(const Ref<CompressedTexture2D> &);
 	typedef void (*TextureFormatRoughnessRequestCallback)(const Ref<CompressedTexture2D> &, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
@@ -107,6 +126,10 @@ public:
 
 	virtual Ref<Image> get_image() const override;
 
+	void request_stream_size(int p_size);
+	int get_stream_size() const;
+	static uint64_t get_stream_memory_usage();
+
 	CompressedTexture2D();
 	~CompressedTexture2D();
 };
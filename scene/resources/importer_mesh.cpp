@@ -30,10 +30,12 @@
 
 #include "importer_mesh.h"
 
+#include "core/crypto/crypto_core.h"
 #include "core/io/marshalls.h"
 #include "core/math/convex_hull.h"
 #include "core/math/random_pcg.h"
 #include "core/math/static_raycaster.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/resources/surface_tool.h"
 
 #include <cstdint>
@@ -269,128 +271,110 @@ void ImporterMesh::set_surface_material(int p_surface, const Ref<Material> &p_ma
 	}                                                                                                              \
 	write_array[vert_idx] = transformed_vert;
 
-void ImporterMesh::generate_lods(float p_normal_merge_angle, float p_normal_split_angle, Array p_bone_transform_array) {
-	if (!SurfaceTool::simplify_scale_func) {
-		return;
-	}
-	if (!SurfaceTool::simplify_with_attrib_func) {
-		return;
-	}
-	if (!SurfaceTool::optimize_vertex_cache_func) {
-		return;
-	}
-
+struct ImporterMesh::LODGenerationData {
+	float normal_merge_angle = 0.0f;
+	float normal_split_angle = 0.0f;
 	LocalVector<Transform3D> bone_transform_vector;
-	for (int i = 0; i < p_bone_transform_array.size(); i++) {
-		ERR_FAIL_COND(p_bone_transform_array[i].get_type() != Variant::TRANSFORM3D);
-		bone_transform_vector.push_back(p_bone_transform_array[i]);
-	}
-
-	for (int i = 0; i < surfaces.size(); i++) {
-		if (surfaces[i].primitive != Mesh::PRIMITIVE_TRIANGLES) {
-			continue;
-		}
+	LocalVector<uint32_t> surface_indices;
+	LocalVector<Ref<StaticRaycaster>> raycasters;
+	Surface *surfaces_ptrw = nullptr;
+};
 
-		surfaces.write[i].lods.clear();
-		Vector<Vector3> vertices = surfaces[i].arrays[RS::ARRAY_VERTEX];
-		PackedInt32Array indices = surfaces[i].arrays[RS::ARRAY_INDEX];
-		Vector<Vector3> normals = surfaces[i].arrays[RS::ARRAY_NORMAL];
-		Vector<Vector2> uvs = surfaces[i].arrays[RS::ARRAY_TEX_UV];
-		Vector<Vector2> uv2s = surfaces[i].arrays[RS::ARRAY_TEX_UV2];
-		Vector<int> bones = surfaces[i].arrays[RS::ARRAY_BONES];
-		Vector<float> weights = surfaces[i].arrays[RS::ARRAY_WEIGHTS];
-
-		unsigned int index_count = indices.size();
-		unsigned int vertex_count = vertices.size();
-
-		if (index_count == 0) {
-			continue; //no lods if no indices
-		}
+void ImporterMesh::_generate_surface_lods(uint32_t p_index, LODGenerationData *p_data) {
+	const uint32_t i = p_data->surface_indices[p_index];
+	Surface &surface = p_data->surfaces_ptrw[i];
+	const LocalVector<Transform3D> &bone_transform_vector = p_data->bone_transform_vector;
+
+	surface.lods.clear();
+	Vector<Vector3> vertices = surface.arrays[RS::ARRAY_VERTEX];
+	PackedInt32Array indices = surface.arrays[RS::ARRAY_INDEX];
+	Vector<Vector3> normals = surface.arrays[RS::ARRAY_NORMAL];
+	Vector<Vector2> uvs = surface.arrays[RS::ARRAY_TEX_UV];
+	Vector<Vector2> uv2s = surface.arrays[RS::ARRAY_TEX_UV2];
+	Vector<int> bones = surface.arrays[RS::ARRAY_BONES];
+	Vector<float> weights = surface.arrays[RS::ARRAY_WEIGHTS];
+
+	unsigned int index_count = indices.size();
+	unsigned int vertex_count = vertices.size();
+
+	if (index_count == 0) {
+		return; //no lods if no indices
+	}
 
-		const Vector3 *vertices_ptr = vertices.ptr();
-		const int *indices_ptr = indices.ptr();
-
-		if (normals.is_empty()) {
-			normals.resize(index_count);
-			Vector3 *n_ptr = normals.ptrw();
-			for (unsigned int j = 0; j < index_count; j += 3) {
-				const Vector3 &v0 = vertices_ptr[indices_ptr[j + 0]];
-				const Vector3 &v1 = vertices_ptr[indices_ptr[j + 1]];
-				const Vector3 &v2 = vertices_ptr[indices_ptr[j + 2]];
-				Vector3 n = vec3_cross(v0 - v2, v0 - v1).normalized();
-				n_ptr[j + 0] = n;
-				n_ptr[j + 1] = n;
-				n_ptr[j + 2] = n;
-			}
+	const Vector3 *vertices_ptr = vertices.ptr();
+	const int *indices_ptr = indices.ptr();
+
+	if (normals.is_empty()) {
+		normals.resize(index_count);
+		Vector3 *n_ptr = normals.ptrw();
+		for (unsigned int j = 0; j < index_count; j += 3) {
+			const Vector3 &v0 = vertices_ptr[indices_ptr[j + 0]];
+			const Vector3 &v1 = vertices_ptr[indices_ptr[j + 1]];
+			const Vector3 &v2 = vertices_ptr[indices_ptr[j + 2]];
+			Vector3 n = vec3_cross(v0 - v2, v0 - v1).normalized();
+			n_ptr[j + 0] = n;
+			n_ptr[j + 1] = n;
+			n_ptr[j + 2] = n;
 		}
+	}
 
-		if (bones.size() > 0 && weights.size() && bone_transform_vector.size() > 0) {
-			Vector3 *vertices_ptrw = vertices.ptrw();
-
-			// Apply bone transforms to regular surface.
-			unsigned int bone_weight_length = surfaces[i].flags & Mesh::ARRAY_FLAG_USE_8_BONE_WEIGHTS ? 8 : 4;
+	if (bones.size() > 0 && weights.size() && bone_transform_vector.size() > 0) {
+		Vector3 *vertices_ptrw = vertices.ptrw();
 
-			const int *bo = bones.ptr();
-			const float *we = weights.ptr();
+		// Apply bone transforms to regular surface.
+		unsigned int bone_weight_length = surface.flags & Mesh::ARRAY_FLAG_USE_8_BONE_WEIGHTS ? 8 : 4;
 
-			for (unsigned int j = 0; j < vertex_count; j++) {
-				VERTEX_SKIN_FUNC(bone_weight_length, j, vertices_ptr, vertices_ptrw, bone_transform_vector, bo, we)
-			}
+		const int *bo = bones.ptr();
+		const float *we = weights.ptr();
 
-			vertices_ptr = vertices.ptr();
+		for (unsigned int j = 0; j < vertex_count; j++) {
+			VERTEX_SKIN_FUNC(bone_weight_length, j, vertices_ptr, vertices_ptrw, bone_transform_vector, bo, we)
 		}
 
-		float normal_merge_threshold = Math::cos(Math::deg_to_rad(p_normal_merge_angle));
-		float normal_pre_split_threshold = Math::cos(Math::deg_to_rad(MIN(180.0f, p_normal_split_angle * 2.0f)));
-		float normal_split_threshold = Math::cos(Math::deg_to_rad(p_normal_split_angle));
-		const Vector3 *normals_ptr = normals.ptr();
-
-		HashMap<Vector3, LocalVector<Pair<int, int>>> unique_vertices;
-
-		LocalVector<int> vertex_remap;
-		LocalVector<int> vertex_inverse_remap;
-		LocalVector<Vector3> merged_vertices;
-		LocalVector<Vector3> merged_normals;
-		LocalVector<int> merged_normals_counts;
-		const Vector2 *uvs_ptr = uvs.ptr();
-		const Vector2 *uv2s_ptr = uv2s.ptr();
+		vertices_ptr = vertices.ptr();
+	}
 
-		for (unsigned int j = 0; j < vertex_count; j++) {
-			const Vector3 &v = vertices_ptr[j];
-			const Vector3 &n = normals_ptr[j];
-
-			HashMap<Vector3, LocalVector<Pair<int, int>>>::Iterator E = unique_vertices.find(v);
-
-			if (E) {
-				const LocalVector<Pair<int, int>> &close_verts = E->value;
-
-				bool found = false;
-				for (const Pair<int, int> &idx : close_verts) {
-					bool is_uvs_close = (!uvs_ptr || uvs_ptr[j].distance_squared_to(uvs_ptr[idx.second]) < CMP_EPSILON2);
-					bool is_uv2s_close = (!uv2s_ptr || uv2s_ptr[j].distance_squared_to(uv2s_ptr[idx.second]) < CMP_EPSILON2);
-					ERR_FAIL_INDEX(idx.second, normals.size());
-					bool is_normals_close = normals[idx.second].dot(n) > normal_merge_threshold;
-					if (is_uvs_close && is_uv2s_close && is_normals_close) {
-						vertex_remap.push_back(idx.first);
-						merged_normals[idx.first] += normals[idx.second];
-						merged_normals_counts[idx.first]++;
-						found = true;
-						break;
-					}
+	float normal_merge_threshold = Math::cos(Math::deg_to_rad(p_data->normal_merge_angle));
+	float normal_pre_split_threshold = Math::cos(Math::deg_to_rad(MIN(180.0f, p_data->normal_split_angle * 2.0f)));
+	float normal_split_threshold = Math::cos(Math::deg_to_rad(p_data->normal_split_angle));
+	const Vector3 *normals_ptr = normals.ptr();
+
+	HashMap<Vector3, LocalVector<Pair<int, int>>> unique_vertices;
+
+	LocalVector<int> vertex_remap;
+	LocalVector<int> vertex_inverse_remap;
+	LocalVector<Vector3> merged_vertices;
+	LocalVector<Vector3> merged_normals;
+	LocalVector<int> merged_normals_counts;
+	const Vector2 *uvs_ptr = uvs.ptr();
+	const Vector2 *uv2s_ptr = uv2s.ptr();
+
+	for (unsigned int j = 0; j < vertex_count; j++) {
+		const Vector3 &v = vertices_ptr[j];
+		const Vector3 &n = normals_ptr[j];
+
+		HashMap<Vector3, LocalVector<Pair<int, int>>>::Iterator E = unique_vertices.find(v);
+
+		if (E) {
+			const LocalVector<Pair<int, int>> &close_verts = E->value;
+
+			bool found = false;
+			for (const Pair<int, int> &idx : close_verts) {
+				bool is_uvs_close = (!uvs_ptr || uvs_ptr[j].distance_squared_to(uvs_ptr[idx.second]) < CMP_EPSILON2);
+				bool is_uv2s_close = (!uv2s_ptr || uv2s_ptr[j].distance_squared_to(uv2s_ptr[idx.second]) < CMP_EPSILON2);
+				ERR_FAIL_INDEX(idx.second, normals.size());
+				bool is_normals_close = normals[idx.second].dot(n) > normal_merge_threshold;
+				if (is_uvs_close && is_uv2s_close && is_normals_close) {
+					vertex_remap.push_back(idx.first);
+					merged_normals[idx.first] += normals[idx.second];
+					merged_normals_counts[idx.first]++;
+					found = true;
+					break;
 				}
+			}
 
-				if (!found) {
-					int vcount = merged_vertices.size();
-					unique_vertices[v].push_back(Pair<int, int>(vcount, j));
-					vertex_inverse_remap.push_back(j);
-					merged_vertices.push_back(v);
-					vertex_remap.push_back(vcount);
-					merged_normals.push_back(normals_ptr[j]);
-					merged_normals_counts.push_back(1);
-				}
-			} else {
+			if (!found) {
 				int vcount = merged_vertices.size();
-				unique_vertices[v] = LocalVector<Pair<int, int>>();
 				unique_vertices[v].push_back(Pair<int, int>(vcount, j));
 				vertex_inverse_remap.push_back(j);
 				merged_vertices.push_back(v);
@@ -398,285 +382,446 @@ void ImporterMesh::generate_lods(float p_normal_merge_angle, float p_normal_spli
 				merged_normals.push_back(normals_ptr[j]);
 				merged_normals_counts.push_back(1);
 			}
+		} else {
+			int vcount = merged_vertices.size();
+			unique_vertices[v] = LocalVector<Pair<int, int>>();
+			unique_vertices[v].push_back(Pair<int, int>(vcount, j));
+			vertex_inverse_remap.push_back(j);
+			merged_vertices.push_back(v);
+			vertex_remap.push_back(vcount);
+			merged_normals.push_back(normals_ptr[j]);
+			merged_normals_counts.push_back(1);
 		}
+	}
 
-		LocalVector<int> merged_indices;
-		merged_indices.resize(index_count);
-		for (unsigned int j = 0; j < index_count; j++) {
-			merged_indices[j] = vertex_remap[indices[j]];
-		}
-
-		unsigned int merged_vertex_count = merged_vertices.size();
-		const Vector3 *merged_vertices_ptr = merged_vertices.ptr();
-		const int32_t *merged_indices_ptr = merged_indices.ptr();
+	LocalVector<int> merged_indices;
+	merged_indices.resize(index_count);
+	for (unsigned int j = 0; j < index_count; j++) {
+		merged_indices[j] = vertex_remap[indices[j]];
+	}
 
-		{
-			const int *counts_ptr = merged_normals_counts.ptr();
-			Vector3 *merged_normals_ptrw = merged_normals.ptr();
-			for (unsigned int j = 0; j < merged_vertex_count; j++) {
-				merged_normals_ptrw[j] /= counts_ptr[j];
-			}
-		}
+	unsigned int merged_vertex_count = merged_vertices.size();
+	const Vector3 *merged_vertices_ptr = merged_vertices.ptr();
+	const int32_t *merged_indices_ptr = merged_indices.ptr();
 
-		LocalVector<float> normal_weights;
-		normal_weights.resize(merged_vertex_count);
+	{
+		const int *counts_ptr = merged_normals_counts.ptr();
+		Vector3 *merged_normals_ptrw = merged_normals.ptr();
 		for (unsigned int j = 0; j < merged_vertex_count; j++) {
-			normal_weights[j] = 2.0; // Give some weight to normal preservation, may be worth exposing as an import setting
+			merged_normals_ptrw[j] /= counts_ptr[j];
 		}
+	}
 
-		Vector<float> merged_vertices_f32 = vector3_to_float32_array(merged_vertices_ptr, merged_vertex_count);
-		float scale = SurfaceTool::simplify_scale_func(merged_vertices_f32.ptr(), merged_vertex_count, sizeof(float) * 3);
+	LocalVector<float> normal_weights;
+	normal_weights.resize(merged_vertex_count);
+	for (unsigned int j = 0; j < merged_vertex_count; j++) {
+		normal_weights[j] = 2.0; // Give some weight to normal preservation, may be worth exposing as an import setting
+	}
 
-		unsigned int index_target = 12; // Start with the smallest target, 4 triangles
-		unsigned int last_index_count = 0;
+	Vector<float> merged_vertices_f32 = vector3_to_float32_array(merged_vertices_ptr, merged_vertex_count);
+	float scale = SurfaceTool::simplify_scale_func(merged_vertices_f32.ptr(), merged_vertex_count, sizeof(float) * 3);
 
-		int split_vertex_count = vertex_count;
-		LocalVector<Vector3> split_vertex_normals;
-		LocalVector<int> split_vertex_indices;
-		split_vertex_normals.reserve(index_count / 3);
-		split_vertex_indices.reserve(index_count / 3);
+	unsigned int index_target = 12; // Start with the smallest target, 4 triangles
+	unsigned int last_index_count = 0;
 
-		RandomPCG pcg;
-		pcg.seed(123456789); // Keep seed constant across imports
+	int split_vertex_count = vertex_count;
+	LocalVector<Vector3> split_vertex_normals;
+	LocalVector<int> split_vertex_indices;
+	split_vertex_normals.reserve(index_count / 3);
+	split_vertex_indices.reserve(index_count / 3);
 
-		Ref<StaticRaycaster> raycaster = StaticRaycaster::create();
-		if (raycaster.is_valid()) {
-			raycaster->add_mesh(vertices, indices, 0);
-			raycaster->commit();
+	RandomPCG pcg;
+	pcg.seed(123456789); // Keep seed constant across imports
+
+	Ref<StaticRaycaster> raycaster = p_data->raycasters[p_index];
+	if (raycaster.is_valid()) {
+		raycaster->add_mesh(vertices, indices, 0);
+		raycaster->commit();
+	}
+
+	const float max_mesh_error = FLT_MAX; // We don't want to limit by error, just by index target
+	float mesh_error = 0.0f;
+
+	while (index_target < index_count) {
+		PackedInt32Array new_indices;
+		new_indices.resize(index_count);
+
+		Vector<float> merged_normals_f32 = vector3_to_float32_array(merged_normals.ptr(), merged_normals.size());
+		const int simplify_options = SurfaceTool::SIMPLIFY_LOCK_BORDER;
+
+		size_t new_index_count = SurfaceTool::simplify_with_attrib_func(
+				(unsigned int *)new_indices.ptrw(),
+				(const uint32_t *)merged_indices_ptr, index_count,
+				merged_vertices_f32.ptr(), merged_vertex_count,
+				sizeof(float) * 3, // Vertex stride
+				index_target,
+				max_mesh_error,
+				simplify_options,
+				&mesh_error,
+				merged_normals_f32.ptr(),
+				normal_weights.ptr(), 3);
+
+		if (new_index_count < last_index_count * 1.5f) {
+			index_target = index_target * 1.5f;
+			continue;
 		}
 
-		const float max_mesh_error = FLT_MAX; // We don't want to limit by error, just by index target
-		float mesh_error = 0.0f;
-
-		while (index_target < index_count) {
-			PackedInt32Array new_indices;
-			new_indices.resize(index_count);
-
-			Vector<float> merged_normals_f32 = vector3_to_float32_array(merged_normals.ptr(), merged_normals.size());
-			const int simplify_options = SurfaceTool::SIMPLIFY_LOCK_BORDER;
-
-			size_t new_index_count = SurfaceTool::simplify_with_attrib_func(
-					(unsigned int *)new_indices.ptrw(),
-					(const uint32_t *)merged_indices_ptr, index_count,
-					merged_vertices_f32.ptr(), merged_vertex_count,
-					sizeof(float) * 3, // Vertex stride
-					index_target,
-					max_mesh_error,
-					simplify_options,
-					&mesh_error,
-					merged_normals_f32.ptr(),
-					normal_weights.ptr(), 3);
-
-			if (new_index_count < last_index_count * 1.5f) {
-				index_target = index_target * 1.5f;
-				continue;
-			}
+		if (new_index_count == 0 || (new_index_count >= (index_count * 0.75f))) {
+			break;
+		}
+		if (new_index_count > 5000000) {
+			// This limit theoretically shouldn't be needed, but it's here
+			// as an ad-hoc fix to prevent a crash with complex meshes.
+			// The crash still happens with limit of 6000000, but 5000000 works.
+			// In the future, identify what's causing that crash and fix it.
+			WARN_PRINT("Mesh LOD generation failed for mesh " + get_name() + " surface " + itos(i) + ", mesh is too complex. Some automatic LODs were not generated.");
+			break;
+		}
 
-			if (new_index_count == 0 || (new_index_count >= (index_count * 0.75f))) {
-				break;
-			}
-			if (new_index_count > 5000000) {
-				// This limit theoretically shouldn't be needed, but it's here
-				// as an ad-hoc fix to prevent a crash with complex meshes.
-				// The crash still happens with limit of 6000000, but 5000000 works.
-				// In the future, identify what's causing that crash and fix it.
-				WARN_PRINT("Mesh LOD generation failed for mesh " + get_name() + " surface " + itos(i) + ", mesh is too complex. Some automatic LODs were not generated.");
-				break;
-			}
+		new_indices.resize(new_index_count);
 
-			new_indices.resize(new_index_count);
+		LocalVector<LocalVector<int>> vertex_corners;
+		vertex_corners.resize(vertex_count);
+		{
+			int *ptrw = new_indices.ptrw();
+			for (unsigned int j = 0; j < new_index_count; j++) {
+				const int &remapped = vertex_inverse_remap[ptrw[j]];
+				vertex_corners[remapped].push_back(j);
+				ptrw[j] = remapped;
+			}
+		}
 
-			LocalVector<LocalVector<int>> vertex_corners;
-			vertex_corners.resize(vertex_count);
-			{
-				int *ptrw = new_indices.ptrw();
-				for (unsigned int j = 0; j < new_index_count; j++) {
-					const int &remapped = vertex_inverse_remap[ptrw[j]];
-					vertex_corners[remapped].push_back(j);
-					ptrw[j] = remapped;
+		if (raycaster.is_valid()) {
+			float error_factor = 1.0f / (scale * MAX(mesh_error, 0.15));
+			const float ray_bias = 0.05;
+			float ray_length = ray_bias + mesh_error * scale * 3.0f;
+
+			Vector<StaticRaycaster::Ray> rays;
+			LocalVector<Vector2> ray_uvs;
+
+			int32_t *new_indices_ptr = new_indices.ptrw();
+
+			int current_ray_count = 0;
+			for (unsigned int j = 0; j < new_index_count; j += 3) {
+				const Vector3 &v0 = vertices_ptr[new_indices_ptr[j + 0]];
+				const Vector3 &v1 = vertices_ptr[new_indices_ptr[j + 1]];
+				const Vector3 &v2 = vertices_ptr[new_indices_ptr[j + 2]];
+				Vector3 face_normal = vec3_cross(v0 - v2, v0 - v1);
+				float face_area = face_normal.length(); // Actually twice the face area, since it's the same error_factor on all faces, we don't care
+				if (!Math::is_finite(face_area) || face_area == 0) {
+					WARN_PRINT_ONCE("Ignoring face with non-finite normal in LOD generation.");
+					continue;
 				}
-			}
 
-			if (raycaster.is_valid()) {
-				float error_factor = 1.0f / (scale * MAX(mesh_error, 0.15));
-				const float ray_bias = 0.05;
-				float ray_length = ray_bias + mesh_error * scale * 3.0f;
-
-				Vector<StaticRaycaster::Ray> rays;
-				LocalVector<Vector2> ray_uvs;
-
-				int32_t *new_indices_ptr = new_indices.ptrw();
-
-				int current_ray_count = 0;
-				for (unsigned int j = 0; j < new_index_count; j += 3) {
-					const Vector3 &v0 = vertices_ptr[new_indices_ptr[j + 0]];
-					const Vector3 &v1 = vertices_ptr[new_indices_ptr[j + 1]];
-					const Vector3 &v2 = vertices_ptr[new_indices_ptr[j + 2]];
-					Vector3 face_normal = vec3_cross(v0 - v2, v0 - v1);
-					float face_area = face_normal.length(); // Actually twice the face area, since it's the same error_factor on all faces, we don't care
-					if (!Math::is_finite(face_area) || face_area == 0) {
-						WARN_PRINT_ONCE("Ignoring face with non-finite normal in LOD generation.");
-						continue;
+				Vector3 dir = face_normal / face_area;
+				int ray_count = CLAMP(5.0 * face_area * error_factor, 16, 64);
+
+				rays.resize(current_ray_count + ray_count);
+				StaticRaycaster::Ray *rays_ptr = rays.ptrw();
+
+				ray_uvs.resize(current_ray_count + ray_count);
+				Vector2 *ray_uvs_ptr = ray_uvs.ptr();
+
+				for (int k = 0; k < ray_count; k++) {
+					float u = pcg.randf();
+					float v = pcg.randf();
+
+					if (u + v >= 1.0f) {
+						u = 1.0f - u;
+						v = 1.0f - v;
 					}
 
-					Vector3 dir = face_normal / face_area;
-					int ray_count = CLAMP(5.0 * face_area * error_factor, 16, 64);
+					u = 0.9f * u + 0.05f / 3.0f; // Give barycentric coordinates some padding, we don't want to sample right on the edge
+					v = 0.9f * v + 0.05f / 3.0f; // v = (v - one_third) * 0.95f + one_third;
+					float w = 1.0f - u - v;
 
-					rays.resize(current_ray_count + ray_count);
-					StaticRaycaster::Ray *rays_ptr = rays.ptrw();
+					Vector3 org = v0 * w + v1 * u + v2 * v;
+					org -= dir * ray_bias;
+					rays_ptr[current_ray_count + k] = StaticRaycaster::Ray(org, dir, 0.0f, ray_length);
+					rays_ptr[current_ray_count + k].id = j / 3;
+					ray_uvs_ptr[current_ray_count + k] = Vector2(u, v);
+				}
 
-					ray_uvs.resize(current_ray_count + ray_count);
-					Vector2 *ray_uvs_ptr = ray_uvs.ptr();
+				current_ray_count += ray_count;
+			}
 
-					for (int k = 0; k < ray_count; k++) {
-						float u = pcg.randf();
-						float v = pcg.randf();
+			raycaster->intersect(rays);
 
-						if (u + v >= 1.0f) {
-							u = 1.0f - u;
-							v = 1.0f - v;
-						}
+			LocalVector<Vector3> ray_normals;
+			LocalVector<real_t> ray_normal_weights;
 
-						u = 0.9f * u + 0.05f / 3.0f; // Give barycentric coordinates some padding, we don't want to sample right on the edge
-						v = 0.9f * v + 0.05f / 3.0f; // v = (v - one_third) * 0.95f + one_third;
-						float w = 1.0f - u - v;
+			ray_normals.resize(new_index_count);
+			ray_normal_weights.resize(new_index_count);
 
-						Vector3 org = v0 * w + v1 * u + v2 * v;
-						org -= dir * ray_bias;
-						rays_ptr[current_ray_count + k] = StaticRaycaster::Ray(org, dir, 0.0f, ray_length);
-						rays_ptr[current_ray_count + k].id = j / 3;
-						ray_uvs_ptr[current_ray_count + k] = Vector2(u, v);
-					}
+			for (unsigned int j = 0; j < new_index_count; j++) {
+				ray_normal_weights[j] = 0.0f;
+			}
 
-					current_ray_count += ray_count;
+			const StaticRaycaster::Ray *rp = rays.ptr();
+			for (int j = 0; j < rays.size(); j++) {
+				if (rp[j].geomID != 0) { // Ray missed
+					continue;
 				}
 
-				raycaster->intersect(rays);
-
-				LocalVector<Vector3> ray_normals;
-				LocalVector<real_t> ray_normal_weights;
+				if (rp[j].normal.normalized().dot(rp[j].dir) > 0.0f) { // Hit a back face.
+					continue;
+				}
 
-				ray_normals.resize(new_index_count);
-				ray_normal_weights.resize(new_index_count);
+				const float &u = rp[j].u;
+				const float &v = rp[j].v;
+				const float w = 1.0f - u - v;
+
+				const unsigned int &hit_tri_id = rp[j].primID;
+				const unsigned int &orig_tri_id = rp[j].id;
+
+				const Vector3 &n0 = normals_ptr[indices_ptr[hit_tri_id * 3 + 0]];
+				const Vector3 &n1 = normals_ptr[indices_ptr[hit_tri_id * 3 + 1]];
+				const Vector3 &n2 = normals_ptr[indices_ptr[hit_tri_id * 3 + 2]];
+				Vector3 normal = n0 * w + n1 * u + n2 * v;
+
+				Vector2 orig_uv = ray_uvs[j];
+				const real_t orig_bary[3] = { 1.0f - orig_uv.x - orig_uv.y, orig_uv.x, orig_uv.y };
+				for (int k = 0; k < 3; k++) {
+					int idx = orig_tri_id * 3 + k;
+					real_t weight = orig_bary[k];
+					ray_normals[idx] += normal * weight;
+					ray_normal_weights[idx] += weight;
+				}
+			}
 
-				for (unsigned int j = 0; j < new_index_count; j++) {
-					ray_normal_weights[j] = 0.0f;
+			for (unsigned int j = 0; j < new_index_count; j++) {
+				if (ray_normal_weights[j] < 1.0f) { // Not enough data, the new normal would be just a bad guess
+					ray_normals[j] = Vector3();
+				} else {
+					ray_normals[j] /= ray_normal_weights[j];
 				}
+			}
 
-				const StaticRaycaster::Ray *rp = rays.ptr();
-				for (int j = 0; j < rays.size(); j++) {
-					if (rp[j].geomID != 0) { // Ray missed
+			LocalVector<LocalVector<int>> normal_group_indices;
+			LocalVector<Vector3> normal_group_averages;
+			normal_group_indices.reserve(24);
+			normal_group_averages.reserve(24);
+
+			for (unsigned int j = 0; j < vertex_count; j++) {
+				const LocalVector<int> &corners = vertex_corners[j];
+				const Vector3 &vertex_normal = normals_ptr[j];
+
+				for (const int &corner_idx : corners) {
+					const Vector3 &ray_normal = ray_normals[corner_idx];
+
+					if (ray_normal.length_squared() < CMP_EPSILON2) {
 						continue;
 					}
 
-					if (rp[j].normal.normalized().dot(rp[j].dir) > 0.0f) { // Hit a back face.
-						continue;
+					bool found = false;
+					for (unsigned int l = 0; l < normal_group_indices.size(); l++) {
+						LocalVector<int> &group_indices = normal_group_indices[l];
+						Vector3 n = normal_group_averages[l] / group_indices.size();
+						if (n.dot(ray_normal) > normal_pre_split_threshold) {
+							found = true;
+							group_indices.push_back(corner_idx);
+							normal_group_averages[l] += ray_normal;
+							break;
+						}
 					}
 
-					const float &u = rp[j].u;
-					const float &v = rp[j].v;
-					const float w = 1.0f - u - v;
-
-					const unsigned int &hit_tri_id = rp[j].primID;
-					const unsigned int &orig_tri_id = rp[j].id;
-
-					const Vector3 &n0 = normals_ptr[indices_ptr[hit_tri_id * 3 + 0]];
-					const Vector3 &n1 = normals_ptr[indices_ptr[hit_tri_id * 3 + 1]];
-					const Vector3 &n2 = normals_ptr[indices_ptr[hit_tri_id * 3 + 2]];
-					Vector3 normal = n0 * w + n1 * u + n2 * v;
-
-					Vector2 orig_uv = ray_uvs[j];
-					const real_t orig_bary[3] = { 1.0f - orig_uv.x - orig_uv.y, orig_uv.x, orig_uv.y };
-					for (int k = 0; k < 3; k++) {
-						int idx = orig_tri_id * 3 + k;
-						real_t weight = orig_bary[k];
-						ray_normals[idx] += normal * weight;
-						ray_normal_weights[idx] += weight;
+					if (!found) {
+						normal_group_indices.push_back({ corner_idx });
+						normal_group_averages.push_back(ray_normal);
 					}
 				}
 
-				for (unsigned int j = 0; j < new_index_count; j++) {
-					if (ray_normal_weights[j] < 1.0f) { // Not enough data, the new normal would be just a bad guess
-						ray_normals[j] = Vector3();
-					} else {
-						ray_normals[j] /= ray_normal_weights[j];
+				for (unsigned int k = 0; k < normal_group_indices.size(); k++) {
+					LocalVector<int> &group_indices = normal_group_indices[k];
+					Vector3 n = normal_group_averages[k] / group_indices.size();
+
+					if (vertex_normal.dot(n) < normal_split_threshold) {
+						split_vertex_indices.push_back(j);
+						split_vertex_normals.push_back(n);
+						int new_idx = split_vertex_count++;
+						for (const int &index : group_indices) {
+							new_indices_ptr[index] = new_idx;
+						}
 					}
 				}
 
-				LocalVector<LocalVector<int>> normal_group_indices;
-				LocalVector<Vector3> normal_group_averages;
-				normal_group_indices.reserve(24);
-				normal_group_averages.reserve(24);
+				normal_group_indices.clear();
+				normal_group_averages.clear();
+			}
+		}
 
-				for (unsigned int j = 0; j < vertex_count; j++) {
-					const LocalVector<int> &corners = vertex_corners[j];
-					const Vector3 &vertex_normal = normals_ptr[j];
+		Surface::LOD lod;
+		lod.distance = MAX(mesh_error * scale, CMP_EPSILON2);
+		lod.indices = new_indices;
+		surface.lods.push_back(lod);
+		index_target = MAX(new_index_count, index_target) * 2;
+		last_index_count = new_index_count;
+
+		if (mesh_error == 0.0f) {
+			break;
+		}
+	}
 
-					for (const int &corner_idx : corners) {
-						const Vector3 &ray_normal = ray_normals[corner_idx];
+	surface.split_normals(split_vertex_indices, split_vertex_normals);
+	surface.lods.sort_custom<Surface::LODComparator>();
 
-						if (ray_normal.length_squared() < CMP_EPSILON2) {
-							continue;
-						}
+	for (int j = 0; j < surface.lods.size(); j++) {
+		Surface::LOD &lod = surface.lods.write[j];
+		unsigned int *lod_indices_ptr = (unsigned int *)lod.indices.ptrw();
+		SurfaceTool::optimize_vertex_cache_func(lod_indices_ptr, lod_indices_ptr, lod.indices.size(), split_vertex_count);
+	}
+}
 
-						bool found = false;
-						for (unsigned int l = 0; l < normal_group_indices.size(); l++) {
-							LocalVector<int> &group_indices = normal_group_indices[l];
-							Vector3 n = normal_group_averages[l] / group_indices.size();
-							if (n.dot(ray_normal) > normal_pre_split_threshold) {
-								found = true;
-								group_indices.push_back(corner_idx);
-								normal_group_averages[l] += ray_normal;
-								break;
-							}
-						}
+void ImporterMesh::generate_lods(float p_normal_merge_angle, float p_normal_split_angle, Array p_bone_transform_array) {
+	if (!SurfaceTool::simplify_scale_func) {
+		return;
+	}
+	if (!SurfaceTool::simplify_with_attrib_func) {
+		return;
+	}
+	if (!SurfaceTool::optimize_vertex_cache_func) {
+		return;
+	}
 
-						if (!found) {
-							normal_group_indices.push_back({ corner_idx });
-							normal_group_averages.push_back(ray_normal);
-						}
-					}
+	LODGenerationData data;
+	data.normal_merge_angle = p_normal_merge_angle;
+	data.normal_split_angle = p_normal_split_angle;
+	for (int i = 0; i < p_bone_transform_array.size(); i++) {
+		ERR_FAIL_COND(p_bone_transform_array[i].get_type() != Variant::TRANSFORM3D);
+		data.bone_transform_vector.push_back(p_bone_transform_array[i]);
+	}
 
-					for (unsigned int k = 0; k < normal_group_indices.size(); k++) {
-						LocalVector<int> &group_indices = normal_group_indices[k];
-						Vector3 n = normal_group_averages[k] / group_indices.size();
-
-						if (vertex_normal.dot(n) < normal_split_threshold) {
-							split_vertex_indices.push_back(j);
-							split_vertex_normals.push_back(n);
-							int new_idx = split_vertex_count++;
-							for (const int &index : group_indices) {
-								new_indices_ptr[index] = new_idx;
-							}
-						}
-					}
+	// Make the surface vector unique up front, so each task can write to its own surface without copy-on-write.
+	data.surfaces_ptrw = surfaces.ptrw();
 
-					normal_group_indices.clear();
-					normal_group_averages.clear();
-				}
-			}
+	for (int i = 0; i < surfaces.size(); i++) {
+		Surface &surface = data.surfaces_ptrw[i];
+		if (surface.primitive != Mesh::PRIMITIVE_TRIANGLES) {
+			continue;
+		}
 
-			Surface::LOD lod;
-			lod.distance = MAX(mesh_error * scale, CMP_EPSILON2);
-			lod.indices = new_indices;
-			surfaces.write[i].lods.push_back(lod);
-			index_target = MAX(new_index_count, index_target) * 2;
-			last_index_count = new_index_count;
+		// Surfaces may have been added from the same Array, and splitting normals writes to it.
+		surface.arrays = surface.arrays.duplicate();
+		for (int j = 0; j < surface.blend_shape_data.size(); j++) {
+			surface.blend_shape_data.write[j].arrays = surface.blend_shape_data[j].arrays.duplicate();
+		}
 
-			if (mesh_error == 0.0f) {
-				break;
-			}
+		data.surface_indices.push_back(i);
+		// Raycasters share a lazily created device, so create them here rather than on the worker threads.
+		data.raycasters.push_back(StaticRaycaster::create());
+	}
+
+	if (data.surface_indices.is_empty()) {
+		return;
+	}
+
+	if (data.surface_indices.size() == 1) {
+		_generate_surface_lods(0, &data);
+		return;
+	}
+
+	// Surfaces are simplified independently (and with a fixed seed each), so the result doesn't depend on scheduling.
+	// LOD levels within a surface stay sequential, as each target index count depends on the previous level.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ImporterMesh::_generate_surface_lods, &data, data.surface_indices.size(), -1, false, SNAME("ImporterMeshGenerateLODs"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+static void _hash_variant(CryptoCore::MD5Context &r_ctx, const Variant &p_variant) {
+	int len = 0;
+	Error err = encode_variant(p_variant, nullptr, len, false);
+	ERR_FAIL_COND(err != OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	encode_variant(p_variant, buffer.ptrw(), len, false);
+	r_ctx.update(buffer.ptr(), buffer.size());
+}
+
+String ImporterMesh::get_content_hash() const {
+	CryptoCore::MD5Context ctx;
+	ctx.start();
+
+	_hash_variant(ctx, blend_shapes);
+	_hash_variant(ctx, int(blend_shape_mode));
+	for (int i = 0; i < surfaces.size(); i++) {
+		_hash_variant(ctx, int(surfaces[i].primitive));
+		_hash_variant(ctx, surfaces[i].flags);
+		_hash_variant(ctx, surfaces[i].arrays);
+		for (int j = 0; j < surfaces[i].blend_shape_data.size(); j++) {
+			_hash_variant(ctx, surfaces[i].blend_shape_data[j].arrays);
 		}
+	}
 
-		surfaces.write[i].split_normals(split_vertex_indices, split_vertex_normals);
-		surfaces.write[i].lods.sort_custom<Surface::LODComparator>();
+	unsigned char hash[16];
+	ctx.finish(hash);
+	return String::hex_encode_buffer(hash, 16);
+}
 
-		for (int j = 0; j < surfaces.write[i].lods.size(); j++) {
-			Surface::LOD &lod = surfaces.write[i].lods.write[j];
-			unsigned int *lod_indices_ptr = (unsigned int *)lod.indices.ptrw();
-			SurfaceTool::optimize_vertex_cache_func(lod_indices_ptr, lod_indices_ptr, lod.indices.size(), split_vertex_count);
+Dictionary ImporterMesh::get_lod_cache_data() const {
+	Dictionary data;
+	Array surface_arr;
+	for (int i = 0; i < surfaces.size(); i++) {
+		Dictionary d;
+		d["arrays"] = surfaces[i].arrays;
+		Array bs_data;
+		for (int j = 0; j < surfaces[i].blend_shape_data.size(); j++) {
+			bs_data.push_back(surfaces[i].blend_shape_data[j].arrays);
+		}
+		d["blend_shapes"] = bs_data;
+		Array lods;
+		for (int j = 0; j < surfaces[i].lods.size(); j++) {
+			lods.push_back(surfaces[i].lods[j].distance);
+			lods.push_back(surfaces[i].lods[j].indices);
 		}
+		d["lods"] = lods;
+		surface_arr.push_back(d);
 	}
+	data["surfaces"] = surface_arr;
+	if (shadow_mesh.is_valid()) {
+		data["shadow_mesh"] = shadow_mesh->_get_data();
+	}
+	return data;
+}
+
+bool ImporterMesh::set_lod_cache_data(const Dictionary &p_data) {
+	Array surface_arr = p_data.get("surfaces", Array());
+	ERR_FAIL_COND_V(surface_arr.size() != surfaces.size(), false);
+
+	// Validate everything first, so a stale or corrupt cache never leaves the mesh half-applied.
+	for (int i = 0; i < surface_arr.size(); i++) {
+		Dictionary d = surface_arr[i];
+		Array arrays = d.get("arrays", Array());
+		Array bs_data = d.get("blend_shapes", Array());
+		Array lods = d.get("lods", Array());
+		ERR_FAIL_COND_V(arrays.size() != RS::ARRAY_MAX, false);
+		ERR_FAIL_COND_V(bs_data.size() != surfaces[i].blend_shape_data.size(), false);
+		ERR_FAIL_COND_V(lods.size() % 2 != 0, false);
+	}
+
+	for (int i = 0; i < surface_arr.size(); i++) {
+		Dictionary d = surface_arr[i];
+		Surface &surface = surfaces.write[i];
+		surface.arrays = d["arrays"];
+		Array bs_data = d["blend_shapes"];
+		for (int j = 0; j < bs_data.size(); j++) {
+			surface.blend_shape_data.write[j].arrays = bs_data[j];
+		}
+		Array lods = d["lods"];
+		surface.lods.clear();
+		for (int j = 0; j < lods.size(); j += 2) {
+			Surface::LOD lod;
+			lod.distance = lods[j];
+			lod.indices = lods[j + 1];
+			surface.lods.push_back(lod);
+		}
+	}
+
+	shadow_mesh.unref();
+	if (p_data.has("shadow_mesh")) {
+		shadow_mesh.instantiate();
+		shadow_mesh->_set_data(p_data["shadow_mesh"]);
+	}
+	mesh.unref();
+	return true;
 }
 
 bool ImporterMesh::has_mesh() const {
@@ -838,6 +983,206 @@ Ref<ImporterMesh> ImporterMesh::get_shadow_mesh() const {
 	return shadow_mesh;
 }
 
+template <typename T>
+static Vector<T> _gather_vertex_data(const Vector<T> &p_src, int p_vertex_count, const LocalVector<int> &p_vertices) {
+	Vector<T> dst;
+	if (p_src.is_empty()) {
+		return dst;
+	}
+
+	int elements = p_src.size() / p_vertex_count;
+	dst.resize(p_vertices.size() * elements);
+	const T *src_ptr = p_src.ptr();
+	T *dst_ptr = dst.ptrw();
+	for (uint32_t i = 0; i < p_vertices.size(); i++) {
+		for (int j = 0; j < elements; j++) {
+			dst_ptr[i * elements + j] = src_ptr[p_vertices[i] * elements + j];
+		}
+	}
+	return dst;
+}
+
+static Array _gather_surface_vertices(const Array &p_arrays, int p_vertex_count, const LocalVector<int> &p_vertices, const PackedInt32Array &p_indices) {
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	for (int i = 0; i < RS::ARRAY_MAX; i++) {
+		if (i == RS::ARRAY_INDEX) {
+			arrays[i] = p_indices;
+			continue;
+		}
+
+		switch (p_arrays[i].get_type()) {
+			case Variant::PACKED_BYTE_ARRAY: {
+				arrays[i] = _gather_vertex_data<uint8_t>(p_arrays[i], p_vertex_count, p_vertices);
+			} break;
+			case Variant::PACKED_INT32_ARRAY: {
+				arrays[i] = _gather_vertex_data<int32_t>(p_arrays[i], p_vertex_count, p_vertices);
+			} break;
+			case Variant::PACKED_FLOAT32_ARRAY: {
+				arrays[i] = _gather_vertex_data<float>(p_arrays[i], p_vertex_count, p_vertices);
+			} break;
+			case Variant::PACKED_VECTOR2_ARRAY: {
+				arrays[i] = _gather_vertex_data<Vector2>(p_arrays[i], p_vertex_count, p_vertices);
+			} break;
+			case Variant::PACKED_VECTOR3_ARRAY: {
+				arrays[i] = _gather_vertex_data<Vector3>(p_arrays[i], p_vertex_count, p_vertices);
+			} break;
+			case Variant::PACKED_COLOR_ARRAY: {
+				arrays[i] = _gather_vertex_data<Color>(p_arrays[i], p_vertex_count, p_vertices);
+			} break;
+			default: {
+				arrays[i] = p_arrays[i];
+			} break;
+		}
+	}
+	return arrays;
+}
+
+Vector<Ref<ImporterMesh>> ImporterMesh::split_into_clusters(int p_max_triangles) const {
+	Vector<Ref<ImporterMesh>> clusters;
+	ERR_FAIL_COND_V(p_max_triangles < 1, clusters);
+
+	if (!SurfaceTool::build_meshlets_bound_func || !SurfaceTool::build_meshlets_func || !SurfaceTool::spatial_sort_remap_func) {
+		return clusters;
+	}
+
+	// Blend shapes and skinning deform the whole mesh, so parts of it can't be culled on their own.
+	if (blend_shapes.size() > 0) {
+		return clusters;
+	}
+	for (int i = 0; i < surfaces.size(); i++) {
+		if (surfaces[i].arrays[RS::ARRAY_BONES].get_type() != Variant::NIL) {
+			return clusters;
+		}
+	}
+
+	const size_t meshlet_max_vertices = 64;
+	const size_t meshlet_max_triangles = 124;
+
+	Ref<ImporterMesh> base;
+	base.instantiate();
+	base->set_name(get_name());
+	base->set_lightmap_size_hint(lightmap_size_hint);
+	if (has_meta("import_id")) {
+		base->set_meta("import_id", get_meta("import_id"));
+	}
+
+	for (int i = 0; i < surfaces.size(); i++) {
+		const Surface &surface = surfaces[i];
+		PackedInt32Array indices = surface.arrays[RS::ARRAY_INDEX];
+
+		if (surface.primitive != Mesh::PRIMITIVE_TRIANGLES || indices.size() / 3 <= p_max_triangles) {
+			Dictionary lods;
+			for (int j = 0; j < surface.lods.size(); j++) {
+				lods[surface.lods[j].distance] = surface.lods[j].indices;
+			}
+			base->add_surface(surface.primitive, surface.arrays, Array(), lods, surface.material, surface.name, surface.flags);
+			continue;
+		}
+
+		PackedVector3Array vertices = surface.arrays[RS::ARRAY_VERTEX];
+		int vertex_count = vertices.size();
+		size_t index_count = indices.size();
+		Vector<float> vertices_f32 = vector3_to_float32_array(vertices.ptr(), vertex_count);
+
+		size_t max_meshlets = SurfaceTool::build_meshlets_bound_func(index_count, meshlet_max_vertices, meshlet_max_triangles);
+		LocalVector<SurfaceTool::Meshlet> meshlets;
+		LocalVector<unsigned int> meshlet_vertices;
+		LocalVector<unsigned char> meshlet_triangles;
+		meshlets.resize(max_meshlets);
+		meshlet_vertices.resize(max_meshlets * meshlet_max_vertices);
+		meshlet_triangles.resize(max_meshlets * meshlet_max_triangles * 3);
+
+		size_t meshlet_count = SurfaceTool::build_meshlets_func(meshlets.ptr(), meshlet_vertices.ptr(), meshlet_triangles.ptr(),
+				(const unsigned int *)indices.ptr(), index_count,
+				vertices_f32.ptr(), vertex_count, sizeof(float) * 3,
+				meshlet_max_vertices, meshlet_max_triangles, 0.0f);
+
+		// Meshlets are small and well shaped. Ordering them along a space filling curve
+		// and merging neighbors gives compact clusters with tight bounds.
+		LocalVector<float> meshlet_centers;
+		meshlet_centers.resize(meshlet_count * 3);
+		for (size_t j = 0; j < meshlet_count; j++) {
+			const SurfaceTool::Meshlet &meshlet = meshlets[j];
+			AABB aabb(vertices[meshlet_vertices[meshlet.vertex_offset]], Vector3());
+			for (unsigned int k = 1; k < meshlet.vertex_count; k++) {
+				aabb.expand_to(vertices[meshlet_vertices[meshlet.vertex_offset + k]]);
+			}
+			Vector3 center = aabb.get_center();
+			meshlet_centers[j * 3 + 0] = center.x;
+			meshlet_centers[j * 3 + 1] = center.y;
+			meshlet_centers[j * 3 + 2] = center.z;
+		}
+
+		LocalVector<unsigned int> remap;
+		remap.resize(meshlet_count);
+		SurfaceTool::spatial_sort_remap_func(remap.ptr(), meshlet_centers.ptr(), meshlet_count, sizeof(float) * 3);
+		LocalVector<unsigned int> order;
+		order.resize(meshlet_count);
+		for (size_t j = 0; j < meshlet_count; j++) {
+			order[remap[j]] = j;
+		}
+
+		LocalVector<int> vertex_map;
+		vertex_map.resize(vertex_count);
+		for (int j = 0; j < vertex_count; j++) {
+			vertex_map[j] = -1;
+		}
+
+		LocalVector<int> cluster_vertices;
+		LocalVector<int> cluster_indices;
+
+		for (size_t j = 0; j <= meshlet_count; j++) {
+			bool flush = j == meshlet_count;
+			if (!flush) {
+				const SurfaceTool::Meshlet &meshlet = meshlets[order[j]];
+				flush = !cluster_indices.is_empty() && (cluster_indices.size() / 3 + meshlet.triangle_count) > (uint32_t)p_max_triangles;
+			}
+
+			if (flush && !cluster_indices.is_empty()) {
+				PackedInt32Array new_indices;
+				new_indices.resize(cluster_indices.size());
+				memcpy(new_indices.ptrw(), cluster_indices.ptr(), sizeof(int) * cluster_indices.size());
+
+				Ref<ImporterMesh> cluster;
+				cluster.instantiate();
+				cluster->set_name(get_name() + "_" + itos(i) + "_" + itos(clusters.size()));
+				cluster->add_surface(surface.primitive, _gather_surface_vertices(surface.arrays, vertex_count, cluster_vertices, new_indices), Array(), Dictionary(), surface.material, surface.name, surface.flags);
+				clusters.push_back(cluster);
+
+				for (const int &vertex : cluster_vertices) {
+					vertex_map[vertex] = -1;
+				}
+				cluster_vertices.clear();
+				cluster_indices.clear();
+			}
+
+			if (j == meshlet_count) {
+				break;
+			}
+
+			const SurfaceTool::Meshlet &meshlet = meshlets[order[j]];
+			for (unsigned int k = 0; k < meshlet.triangle_count * 3; k++) {
+				int vertex = meshlet_vertices[meshlet.vertex_offset + meshlet_triangles[meshlet.triangle_offset + k]];
+				if (vertex_map[vertex] < 0) {
+					vertex_map[vertex] = cluster_vertices.size();
+					cluster_vertices.push_back(vertex);
+				}
+				cluster_indices.push_back(vertex_map[vertex]);
+			}
+		}
+	}
+
+	if (clusters.is_empty()) {
+		return clusters;
+	}
+
+	if (base->get_surface_count() > 0) {
+		clusters.insert(0, base);
+	}
+	return clusters;
+}
+
 void ImporterMesh::_set_data(const Dictionary &p_data) {
 	clear();
 	if (p_data.has("blend_shape_names")) {
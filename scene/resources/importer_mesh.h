@@ -82,6 +82,9 @@ class ImporterMesh : public Resource {
 
 	Size2i lightmap_size_hint;
 
+	struct LODGenerationData;
+	void _generate_surface_lods(uint32_t p_index, LODGenerationData *p_data);
+
 protected:
 	void _set_data(const Dictionary &p_data);
 	Dictionary _get_data() const;
@@ -117,6 +120,17 @@ public:
 	void create_shadow_mesh();
 	Ref<ImporterMesh> get_shadow_mesh() const;
 
+	// Splits large static triangle surfaces into spatially compact meshes, so each part can be culled on its own.
+	// Smaller surfaces are kept together in the first mesh. Returns an empty vector if nothing was split.
+	Vector<Ref<ImporterMesh>> split_into_clusters(int p_max_triangles) const;
+
+	// Used by the scene importer to skip LOD and shadow mesh generation when the source mesh didn't change.
+	// Bump LOD_CACHE_FORMAT_VERSION whenever the cache data layout changes.
+	static const int LOD_CACHE_FORMAT_VERSION = 1;
+	String get_content_hash() const;
+	Dictionary get_lod_cache_data() const;
+	bool set_lod_cache_data(const Dictionary &p_data);
+
 	Vector<Face3> get_faces() const;
 	Vector<Ref<Shape3D>> convex_decompose(const Ref<MeshConvexDecompositionSettings> &p_settings) const;
 	Ref<ConvexPolygonShape3D> create_convex_shape(bool p_clean = true, bool p_simplify = false) const;
@@ -98,6 +98,18 @@ public:
 	static RemapVertexFunc remap_vertex_func;
 	typedef void (*RemapIndexFunc)(unsigned int *destination, const unsigned int *indices, size_t index_count, const unsigned int *remap);
 	static RemapIndexFunc remap_index_func;
+	struct Meshlet {
+		unsigned int vertex_offset = 0;
+		unsigned int triangle_offset = 0;
+		unsigned int vertex_count = 0;
+		unsigned int triangle_count = 0;
+	};
+	typedef size_t (*BuildMeshletsBoundFunc)(size_t index_count, size_t max_vertices, size_t max_triangles);
+	static BuildMeshletsBoundFunc build_meshlets_bound_func;
+	typedef size_t (*BuildMeshletsFunc)(Meshlet *meshlets, unsigned int *meshlet_vertices, unsigned char *meshlet_triangles, const unsigned int *indices, size_t index_count, const float *vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight);
+	static BuildMeshletsFunc build_meshlets_func;
+	typedef void (*SpatialSortRemapFunc)(unsigned int *destination, const float *vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
+	static SpatialSortRemapFunc spatial_sort_remap_func;
 	static void strip_mesh_arrays(PackedVector3Array &r_vertices, PackedInt32Array &r_indices);
 
 private:
@@ -42,6 +42,7 @@ private:
 
 	struct DummyTexture {
 		Ref<Image> image;
+		String path;
 	};
 	mutable RID_PtrOwner<DummyTexture> texture_owner;
 
@@ -111,11 +112,26 @@ public:
 	virtual Ref<Image> texture_2d_layer_get(RID p_texture, int p_layer) const override { return Ref<Image>(); };
 	virtual Vector<Ref<Image>> texture_3d_get(RID p_texture) const override { return Vector<Ref<Image>>(); };
 
-	virtual void texture_replace(RID p_texture, RID p_by_texture) override { texture_free(p_by_texture); };
+	virtual void texture_replace(RID p_texture, RID p_by_texture) override {
+		DummyTexture *t = texture_owner.get_or_null(p_texture);
+		ERR_FAIL_NULL(t);
+		DummyTexture *by_t = texture_owner.get_or_null(p_by_texture);
+		ERR_FAIL_NULL(by_t);
+		t->image = by_t->image;
+		texture_free(p_by_texture);
+	};
 	virtual void texture_set_size_override(RID p_texture, int p_width, int p_height) override{};
 
-	virtual void texture_set_path(RID p_texture, const String &p_path) override{};
-	virtual String texture_get_path(RID p_texture) const override { return String(); };
+	virtual void texture_set_path(RID p_texture, const String &p_path) override {
+		DummyTexture *t = texture_owner.get_or_null(p_texture);
+		ERR_FAIL_NULL(t);
+		t->path = p_path;
+	};
+	virtual String texture_get_path(RID p_texture) const override {
+		DummyTexture *t = texture_owner.get_or_null(p_texture);
+		ERR_FAIL_NULL_V(t, String());
+		return t->path;
+	};
 
 	virtual Image::Format texture_get_format(RID p_texture) const override { return Image::FORMAT_MAX; }
 
@@ -123,7 +139,26 @@ public:
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override{};
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) override{};
 
-	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info) override{};
+	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info) override {
+		// Report the memory the images would take on the GPU, so resource usage can be tested without a GPU.
+		List<RID> textures;
+		texture_owner.get_owned_list(&textures);
+		for (const RID &rid : textures) {
+			DummyTexture *t = texture_owner.get_or_null(rid);
+			if (!t || t->image.is_null()) {
+				continue;
+			}
+			RS::TextureInfo tinfo;
+			tinfo.texture = rid;
+			tinfo.path = t->path;
+			tinfo.format = t->image->get_format();
+			tinfo.width = t->image->get_width();
+			tinfo.height = t->image->get_height();
+			tinfo.depth = 0;
+			tinfo.bytes = t->image->get_data().size();
+			r_info->push_back(tinfo);
+		}
+	};
 
 	virtual void texture_set_force_redraw_if_visible(RID p_texture, bool p_enable) override{};
 
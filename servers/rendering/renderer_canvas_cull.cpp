@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
+#include "core/object/worker_thread_pool.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -186,6 +187,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		//something to draw?
 
 		if (ci->update_when_visible) {
+			MutexLock lock(visibility_notifier_mutex);
 			RenderingServerDefault::redraw_request();
 		}
 
@@ -214,6 +216,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
+				MutexLock lock(visibility_notifier_mutex);
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
 				ci->visibility_notifier->just_visible = true;
 			}
@@ -239,7 +242,8 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		ci->children_order_dirty = false;
 	}
 
-	Rect2 rect = ci->get_rect();
+	// Workers can't read storage, those rects were refreshed by _refresh_storage_rects() before they started.
+	Rect2 rect = (threaded_cull_active && ci->storage_rect_element.in_list()) ? ci->rect : ci->get_rect();
 
 	if (ci->visibility_notifier) {
 		if (ci->visibility_notifier->area.size != Vector2()) {
@@ -317,8 +321,21 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			SortArray<Item *, ItemPtrSort> sorter;
 			sorter.sort(child_items, child_item_count);
 
-			for (i = 0; i < child_item_count; i++) {
-				_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, canvas_cull_mask);
+			if (!threaded_cull_active && threaded_cull_lists.size() > 1 && (uint32_t)child_item_count >= threaded_cull_minimum_children) {
+				ThreadedCullData cull_data;
+				cull_data.child_items = child_items;
+				cull_data.child_item_count = child_item_count;
+				cull_data.y_sorted = true;
+				cull_data.xform = xform;
+				cull_data.clip_rect = p_clip_rect;
+				cull_data.modulate = modulate;
+				cull_data.canvas_clip = (Item *)ci->final_clip_owner;
+				cull_data.canvas_cull_mask = canvas_cull_mask;
+				_cull_canvas_item_children(cull_data, r_z_list, r_z_last_list);
+			} else {
+				for (i = 0; i < child_item_count; i++) {
+					_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, canvas_cull_mask);
+				}
 			}
 		} else {
 			RendererCanvasRender::Item *canvas_group_from = nullptr;
@@ -338,6 +355,29 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			canvas_group_from = r_z_last_list[zidx];
 		}
 
+		if (!threaded_cull_active && threaded_cull_lists.size() > 1 && (uint32_t)child_item_count >= threaded_cull_minimum_children) {
+			ThreadedCullData cull_data;
+			cull_data.child_items = child_items;
+			cull_data.child_item_count = child_item_count;
+			cull_data.use_canvas_group = use_canvas_group;
+			cull_data.xform = xform;
+			cull_data.clip_rect = p_clip_rect;
+			cull_data.modulate = modulate;
+			cull_data.z = p_z;
+			cull_data.canvas_clip = (Item *)ci->final_clip_owner;
+			cull_data.material_owner = p_material_owner;
+			cull_data.canvas_cull_mask = canvas_cull_mask;
+
+			cull_data.behind_pass = true;
+			_cull_canvas_item_children(cull_data, r_z_list, r_z_last_list);
+			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from, xform);
+			if (!use_canvas_group) {
+				cull_data.behind_pass = false;
+				_cull_canvas_item_children(cull_data, r_z_list, r_z_last_list);
+			}
+			return;
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
@@ -354,6 +394,64 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 }
 
+void RendererCanvasCull::_refresh_storage_rects() {
+	for (SelfList<Item> *E = storage_rect_items.first(); E; E = E->next()) {
+		E->self()->get_rect();
+	}
+}
+
+void RendererCanvasCull::_cull_canvas_item_children_range(ThreadedCullData *p_data, uint32_t p_from, uint32_t p_to, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		Item *child = p_data->child_items[i];
+		if (p_data->y_sorted) {
+			_cull_canvas_item(child, p_data->xform * child->ysort_xform, p_data->clip_rect, p_data->modulate * child->ysort_modulate, child->ysort_parent_abs_z_index, r_z_list, r_z_last_list, p_data->canvas_clip, (Item *)child->material_owner, false, p_data->canvas_cull_mask);
+		} else {
+			if ((child->behind || p_data->use_canvas_group) != p_data->behind_pass) {
+				continue;
+			}
+			_cull_canvas_item(child, p_data->xform, p_data->clip_rect, p_data->modulate, p_data->z, r_z_list, r_z_last_list, p_data->canvas_clip, p_data->material_owner, true, p_data->canvas_cull_mask);
+		}
+	}
+}
+
+void RendererCanvasCull::_cull_canvas_item_children_threaded(uint32_t p_chunk, ThreadedCullData *p_data) {
+	ThreadedCullLists &lists = threaded_cull_lists[p_chunk];
+	memset(lists.z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	memset(lists.z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+
+	uint32_t from = p_chunk * p_data->chunk_size;
+	uint32_t to = MIN(from + p_data->chunk_size, p_data->child_item_count);
+	_cull_canvas_item_children_range(p_data, from, to, lists.z_list, lists.z_last_list);
+}
+
+void RendererCanvasCull::_cull_canvas_item_children(ThreadedCullData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list) {
+	_refresh_storage_rects();
+
+	uint32_t chunk_count = MIN(threaded_cull_lists.size(), (p_data.child_item_count + 63) / 64);
+	p_data.chunk_size = (p_data.child_item_count + chunk_count - 1) / chunk_count;
+
+	threaded_cull_active = true;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_item_children_threaded, &p_data, chunk_count, -1, true, SNAME("CullCanvasItems"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	threaded_cull_active = false;
+
+	// Append the chunks in order, so each z layer keeps the order of the serial walk.
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		const ThreadedCullLists &lists = threaded_cull_lists[i];
+		for (int j = 0; j < z_range; j++) {
+			if (!lists.z_list[j]) {
+				continue;
+			}
+			if (r_z_last_list[j]) {
+				r_z_last_list[j]->next = lists.z_list[j];
+			} else {
+				r_z_list[j] = lists.z_list[j];
+			}
+			r_z_last_list[j] = lists.z_last_list[j];
+		}
+	}
+}
+
 void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask) {
 	RENDER_TIMESTAMP("> Render Canvas");
 
@@ -1424,6 +1522,9 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
 	ERR_FAIL_NULL(m);
+	if (!canvas_item->storage_rect_element.in_list()) {
+		storage_rect_items.add(&canvas_item->storage_rect_element);
+	}
 	m->mesh = p_mesh;
 	if (canvas_item->skeleton.is_valid()) {
 		m->mesh_instance = RSG::mesh_storage->mesh_instance_create(p_mesh);
@@ -1442,6 +1543,9 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_NULL(part);
+	if (!canvas_item->storage_rect_element.in_list()) {
+		storage_rect_items.add(&canvas_item->storage_rect_element);
+	}
 	part->particles = p_particles;
 
 	part->texture = p_texture;
@@ -1456,6 +1560,9 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_NULL(mm);
+	if (!canvas_item->storage_rect_element.in_list()) {
+		storage_rect_items.add(&canvas_item->storage_rect_element);
+	}
 	mm->multimesh = p_mesh;
 
 	mm->texture = p_texture;
@@ -1558,6 +1665,9 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->clear();
+	if (canvas_item->storage_rect_element.in_list()) {
+		storage_rect_items.remove(&canvas_item->storage_rect_element);
+	}
 #ifdef DEBUG_ENABLED
 	if (debug_redraw) {
 		canvas_item->debug_redraw_time = debug_redraw_time;
@@ -2169,9 +2279,26 @@ RendererCanvasCull::RendererCanvasCull() {
 
 	debug_redraw_time = GLOBAL_DEF("debug/canvas_items/debug_redraw_time", 1.0);
 	debug_redraw_color = GLOBAL_DEF("debug/canvas_items/debug_redraw_color", Color(1.0, 0.2, 0.2, 0.5));
+
+	threaded_cull_minimum_children = GLOBAL_GET("rendering/limits/canvas_cull/threaded_cull_minimum_children");
+
+	threaded_cull_lists.resize(WorkerThreadPool::get_singleton()->get_thread_count());
+	for (ThreadedCullLists &lists : threaded_cull_lists) {
+		lists.z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+		lists.z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+	}
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
+	while (storage_rect_items.first()) {
+		storage_rect_items.remove(storage_rect_items.first());
+	}
+
 	memfree(z_list);
 	memfree(z_last_list);
+
+	for (ThreadedCullLists &lists : threaded_cull_lists) {
+		memfree(lists.z_list);
+		memfree(lists.z_last_list);
+	}
 }
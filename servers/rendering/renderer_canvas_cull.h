@@ -31,6 +31,8 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
@@ -72,7 +74,11 @@ public:
 
 		VisibilityNotifierData *visibility_notifier = nullptr;
 
-		Item() {
+		// In storage_rect_items while it draws meshes, multimeshes or particles.
+		SelfList<Item> storage_rect_element;
+
+		Item() :
+				storage_rect_element(this) {
 			children_order_dirty = true;
 			E = nullptr;
 			z_index = 0;
@@ -180,6 +186,7 @@ public:
 
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
+	BinaryMutex visibility_notifier_mutex; // Culling may run on several threads.
 
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &xform, const Rect2 &p_clip_rect, Rect2 global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *canvas_group_from, const Transform2D &p_xform);
 
@@ -192,7 +199,46 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// Threaded culling of wide subtrees. Every chunk of children is culled into its own
+	// z lists, which are then appended in chunk order, so draw order matches the serial walk.
+
+	struct ThreadedCullLists {
+		RendererCanvasRender::Item **z_list = nullptr;
+		RendererCanvasRender::Item **z_last_list = nullptr;
+	};
+
+	struct ThreadedCullData {
+		Item **child_items = nullptr;
+		uint32_t child_item_count = 0;
+		uint32_t chunk_size = 0;
+		bool y_sorted = false;
+		bool behind_pass = false;
+		bool use_canvas_group = false;
+		Transform2D xform;
+		Rect2 clip_rect;
+		Color modulate;
+		int z = 0;
+		Item *canvas_clip = nullptr;
+		Item *material_owner = nullptr;
+		uint32_t canvas_cull_mask = 0;
+	};
+
+	LocalVector<ThreadedCullLists> threaded_cull_lists;
+	uint32_t threaded_cull_minimum_children = 1024;
+	bool threaded_cull_active = false;
+
+	// Rects of these items come from mesh or particles storage, which worker threads can't read.
+	// They are refreshed before culling on workers, which then only read the cached rects.
+	SelfList<Item>::List storage_rect_items;
+
+	void _refresh_storage_rects();
+	void _cull_canvas_item_children_range(ThreadedCullData *p_data, uint32_t p_from, uint32_t p_to, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list);
+	void _cull_canvas_item_children_threaded(uint32_t p_chunk, ThreadedCullData *p_data);
+	void _cull_canvas_item_children(ThreadedCullData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list);
+
 public:
+	void set_threaded_cull_minimum_children(uint32_t p_count) { threaded_cull_minimum_children = p_count; }
+
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask);
 
 	bool was_sdf_used();
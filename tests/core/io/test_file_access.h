@@ -31,7 +31,13 @@
 #ifndef TEST_FILE_ACCESS_H
 #define TEST_FILE_ACCESS_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
+#include "core/os/os.h"
+#include "drivers/unix/file_access_unix.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +113,284 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Read binary values from a large file") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	const String source_path = cache_path.path_join("file_access_large.bin");
+	const String pack_path = cache_path.path_join("file_access_large.pck");
+	// Read through a mounted pack, which is a read-only source that can be memory-mapped.
+	const String file_path = "res://file_access_large/large.bin";
+	const uint32_t count = 32 * 1024; // 128 KiB, big enough to be memory-mapped where supported.
+
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		for (uint32_t i = 0; i < count; i++) {
+			f->store_32(i * 2654435761u);
+		}
+		f->store_16(0xBEEF);
+		f->store_8(0x42);
+	}
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(pack_path) == OK);
+	REQUIRE(pck_packer.add_file(file_path, source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(pack_path, false, 0) == OK);
+
+#ifdef UNIX_ENABLED
+	// Mapping is off in editor builds by default, force it so the mapped read path is covered.
+	const bool was_using_mmap = FileAccessUnix::is_using_mmap();
+	FileAccessUnix::set_use_mmap(true);
+	const uint32_t mapping_count = FileAccessUnix::get_shared_mapping_count();
+#endif
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == count * 4 + 3);
+#ifdef UNIX_ENABLED
+	CHECK(FileAccessUnix::get_shared_mapping_count() == mapping_count + 1);
+#endif
+
+	bool values_match = true;
+	for (uint32_t i = 0; i < count; i++) {
+		values_match = values_match && f->get_32() == i * 2654435761u;
+	}
+	CHECK(values_match);
+	CHECK(f->get_16() == 0xBEEF);
+	CHECK(f->get_8() == 0x42);
+	CHECK_FALSE(f->eof_reached());
+	f->get_8();
+	CHECK(f->eof_reached());
+
+	f->seek(4);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(f->get_position() == 4);
+	CHECK(f->get_64() == ((uint64_t(2u * 2654435761u) << 32) | 2654435761u));
+
+	f->set_big_endian(true);
+	f->seek(4);
+	CHECK(f->get_32() == BSWAP32(2654435761u));
+	f->set_big_endian(false);
+
+	f->seek_end(-3);
+	uint8_t tail[8] = {};
+	CHECK(f->get_buffer(tail, 8) == 3);
+	CHECK(tail[0] == 0xEF);
+	CHECK(tail[1] == 0xBE);
+	CHECK(tail[2] == 0x42);
+	CHECK(f->eof_reached());
+
+	// Another access to the same pack reuses the mapping, with its own position.
+	Ref<FileAccess> f2 = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f2.is_valid());
+	CHECK(f2->get_position() == 0);
+	CHECK(f2->get_32() == 0);
+	CHECK(f->eof_reached());
+#ifdef UNIX_ENABLED
+	CHECK(FileAccessUnix::get_shared_mapping_count() == mapping_count + 1);
+#endif
+
+	f.unref();
+	f2.unref();
+	DirAccess::remove_absolute(source_path);
+	DirAccess::remove_absolute(pack_path);
+
+#ifdef UNIX_ENABLED
+	CHECK(FileAccessUnix::get_shared_mapping_count() == mapping_count);
+	FileAccessUnix::set_use_mmap(was_using_mmap);
+#endif
+}
+
+TEST_CASE("[FileAccess] Truncate a large user file while it is being read") {
+	const String file_path = OS::get_singleton()->get_cache_path().path_join("file_access_truncated.bin");
+	const uint32_t count = 32 * 1024; // 128 KiB, big enough to be memory-mapped if it were a read-only source.
+
+	{
+		Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		for (uint32_t i = 0; i < count; i++) {
+			f->store_32(i);
+		}
+	}
+
+#ifdef UNIX_ENABLED
+	const bool was_using_mmap = FileAccessUnix::is_using_mmap();
+	FileAccessUnix::set_use_mmap(true);
+#endif
+
+	Ref<FileAccess> reader = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(reader.is_valid());
+	CHECK(reader->get_32() == 0);
+#ifdef UNIX_ENABLED
+	// Files that can be written to aren't mapped, a mapping would fault once the file is truncated under it.
+	FileAccessUnix *reader_unix = dynamic_cast<FileAccessUnix *>(reader.ptr());
+	REQUIRE(reader_unix);
+	CHECK_FALSE(reader_unix->is_mapped());
+#endif
+
+	{
+		// Rewrites the file in place, like a game overwriting its save.
+		Ref<FileAccess> writer = FileAccess::open(file_path, FileAccess::WRITE);
+		REQUIRE(writer.is_valid());
+		writer->store_32(0xCAFEBABE);
+	}
+
+	// Reading past the new end stops at the end of the file.
+	reader->seek((count - 1) * 4);
+	uint8_t buffer[4] = {};
+	CHECK(reader->get_buffer(buffer, 4) == 0);
+	CHECK(reader->eof_reached());
+	reader->seek(0);
+	CHECK(reader->get_32() == 0xCAFEBABE);
+
+	reader.unref();
+#ifdef UNIX_ENABLED
+	FileAccessUnix::set_use_mmap(was_using_mmap);
+#endif
+	DirAccess::remove_absolute(file_path);
+}
+
+TEST_CASE("[FileAccess] Seek and read in compressed files") {
+	const String file_path = OS::get_singleton()->get_cache_path().path_join("file_access_compressed.bin");
+	// A multiple of the default block size, so the last block is empty.
+	const int size = 4096 * 4;
+
+	Vector<uint8_t> data;
+	data.resize(size);
+	for (int i = 0; i < size; i++) {
+		data.write[i] = (i * 7) ^ (i >> 8);
+	}
+
+	{
+		Ref<FileAccess> f = FileAccess::open_compressed(file_path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+	}
+	CHECK_MESSAGE(FileAccess::get_file_as_bytes(file_path) == FileAccessCompressed::compress_blocks(data.ptr(), size, "GCPF", Compression::MODE_ZSTD, 4096), "Files should be written in the same layout as compress_blocks().");
+
+	Ref<FileAccess> f = FileAccess::open_compressed(file_path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == size);
+
+	// Jump back and forth between blocks.
+	const int positions[] = { 10000, 100, 12000, 4095, 10001, 0, 8192 };
+	for (int position : positions) {
+		f->seek(position);
+		uint8_t buffer[300];
+		uint64_t read = f->get_buffer(buffer, 300);
+		CHECK(read == 300);
+		CHECK(memcmp(buffer, &data[position], 300) == 0);
+		CHECK(f->get_position() == position + 300);
+	}
+
+	f->seek(size - 2);
+	CHECK(f->get_8() == data[size - 2]);
+	CHECK(f->get_8() == data[size - 1]);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(f->get_position() == size);
+	f->get_8();
+	CHECK(f->eof_reached());
+
+	f->seek(0);
+	Vector<uint8_t> all = f->get_buffer(size + 10);
+	CHECK(all == data);
+	CHECK(f->eof_reached());
+
+	f.unref();
+	DirAccess::remove_absolute(file_path);
+}
+
+static void async_read_callback(void *p_userdata, Error p_error, uint64_t p_read) {
+	if (p_error == OK) {
+		((SafeNumeric<uint64_t> *)p_userdata)->add(p_read);
+	}
+}
+
+TEST_CASE("[FileAccess] Read buffers asynchronously") {
+	const String file_path = OS::get_singleton()->get_cache_path().path_join("file_access_async.bin");
+	const int chunk_count = 8;
+	const int chunk_size = 2048;
+
+	{
+		Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		for (int i = 0; i < chunk_count * chunk_size; i++) {
+			f->store_8(i * 31 + i / 256);
+		}
+	}
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(100);
+
+	Vector<uint8_t> buffers[chunk_count];
+	uint64_t read[chunk_count] = {};
+	SafeNumeric<uint64_t> read_total;
+	FileAccess::AsyncReadID ids[chunk_count];
+	for (int i = 0; i < chunk_count; i++) {
+		buffers[i].resize(chunk_size);
+		// Read the chunks backwards, to make sure offsets are honored.
+		ids[i] = f->get_buffer_async((chunk_count - 1 - i) * chunk_size, buffers[i].ptrw(), chunk_size, &read[i], async_read_callback, &read_total);
+	}
+	for (int i = 0; i < chunk_count; i++) {
+		FileAccess::wait_for_async_read(ids[i]);
+	}
+
+	CHECK(read_total.get() == chunk_count * chunk_size);
+	bool data_matches = true;
+	for (int i = 0; i < chunk_count; i++) {
+		CHECK(read[i] == chunk_size);
+		for (int j = 0; j < chunk_size; j++) {
+			int offset = (chunk_count - 1 - i) * chunk_size + j;
+			data_matches = data_matches && buffers[i][j] == uint8_t(offset * 31 + offset / 256);
+		}
+	}
+	CHECK(data_matches);
+	CHECK_MESSAGE(f->get_position() == 100, "Reading at an offset shouldn't move the cursor.");
+
+	uint8_t tail[16] = {};
+	CHECK(f->get_buffer_at(chunk_count * chunk_size - 4, tail, 16) == 4);
+	CHECK(f->get_buffer_at(chunk_count * chunk_size + 4, tail, 16) == 0);
+
+	// Compressed files read at an offset through their cursor, so the reads in flight take turns.
+	const String compressed_path = OS::get_singleton()->get_cache_path().path_join("file_access_async_compressed.bin");
+	{
+		Ref<FileAccess> fc = FileAccess::open_compressed(compressed_path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(fc.is_valid());
+		f->seek(0);
+		fc->store_buffer(f->get_buffer(chunk_count * chunk_size));
+	}
+
+	Ref<FileAccess> fc = FileAccess::open_compressed(compressed_path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(fc.is_valid());
+	fc->seek(100);
+	read_total.set(0);
+	for (int i = 0; i < chunk_count; i++) {
+		buffers[i].fill(0);
+		ids[i] = fc->get_buffer_async((chunk_count - 1 - i) * chunk_size, buffers[i].ptrw(), chunk_size, &read[i], async_read_callback, &read_total);
+	}
+	for (int i = 0; i < chunk_count; i++) {
+		FileAccess::wait_for_async_read(ids[i]);
+	}
+
+	CHECK(read_total.get() == chunk_count * chunk_size);
+	data_matches = true;
+	for (int i = 0; i < chunk_count; i++) {
+		for (int j = 0; j < chunk_size; j++) {
+			int offset = (chunk_count - 1 - i) * chunk_size + j;
+			data_matches = data_matches && buffers[i][j] == uint8_t(offset * 31 + offset / 256);
+		}
+	}
+	CHECK_MESSAGE(data_matches, "Concurrent reads through the cursor should each read their own offset.");
+	CHECK(fc->get_position() == 100);
+
+	fc.unref();
+	f.unref();
+	DirAccess::remove_absolute(compressed_path);
+	DirAccess::remove_absolute(file_path);
+}
+
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -326,6 +326,62 @@ TEST_CASE("[Marshalls] FLOAT double precision Variant decoding") {
 	CHECK(r_len == 12);
 	CHECK(variant == Variant(0.33333333333333333));
 }
+
+TEST_CASE("[Marshalls] Packed array Variant encoding") {
+	PackedInt32Array ints;
+	ints.push_back(0x12345678);
+	ints.push_back(-2);
+	int r_len;
+	uint8_t buffer[16];
+
+	CHECK(encode_variant(ints, buffer, r_len) == OK);
+	CHECK_MESSAGE(r_len == 16, "Length == 4 bytes for Variant::Type + 4 bytes for count + 2 * 4 bytes for int32_t");
+	CHECK_MESSAGE(buffer[0] == Variant::PACKED_INT32_ARRAY, "Variant::PACKED_INT32_ARRAY");
+	CHECK(buffer[4] == 0x02);
+	// Values are stored as little-endian regardless of the host.
+	CHECK(buffer[8] == 0x78);
+	CHECK(buffer[9] == 0x56);
+	CHECK(buffer[10] == 0x34);
+	CHECK(buffer[11] == 0x12);
+	CHECK(buffer[12] == 0xfe);
+	CHECK(buffer[15] == 0xff);
+}
+
+TEST_CASE("[Marshalls] Packed array Variant round trip") {
+	PackedByteArray bytes;
+	PackedInt64Array ints;
+	PackedFloat32Array floats;
+	PackedFloat64Array doubles;
+	PackedVector2Array vectors2;
+	PackedVector3Array vectors3;
+	PackedColorArray colors;
+	for (int i = 0; i < 37; i++) {
+		bytes.push_back(i * 7);
+		ints.push_back(int64_t(i) << 40 | i);
+		floats.push_back(i * 0.25f);
+		doubles.push_back(i / 3.0);
+		vectors2.push_back(Vector2(i, -i));
+		vectors3.push_back(Vector3(i, i * 0.5, -i));
+		colors.push_back(Color(i / 37.0, 0.5, 1.0, 0.25));
+	}
+
+	const Variant values[] = { bytes, ints, floats, doubles, vectors2, vectors3, colors };
+	for (const Variant &value : values) {
+		int len;
+		CHECK(encode_variant(value, nullptr, len) == OK);
+		Vector<uint8_t> buffer;
+		buffer.resize(len);
+		int written;
+		CHECK(encode_variant(value, buffer.ptrw(), written) == OK);
+		CHECK(written == len);
+
+		Variant decoded;
+		int read;
+		CHECK(decode_variant(decoded, buffer.ptr(), buffer.size(), &read) == OK);
+		CHECK(read == len);
+		CHECK_MESSAGE(decoded == value, vformat("Decoded %s should match the encoded one.", Variant::get_type_name(value.get_type())));
+	}
+}
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
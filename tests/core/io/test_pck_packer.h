@@ -62,6 +62,11 @@ TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	CHECK_MESSAGE(
 			f->get_length() <= 500,
 			"The generated empty PCK file shouldn't be too large.");
+
+	f->seek(4);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION_NO_COMPRESSION,
+			"PCKs without compressed files should keep the format version older engines can read.");
 }
 
 TEST_CASE("[PCKPacker] Pack empty with zero alignment invalid") {
@@ -117,6 +122,41 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Packed files with colliding path hashes stay apart") {
+	// Both names get the same djb2 hash, which is what PackedData hashes paths with.
+	const String path_a = "res://pck_collision/Aa.txt";
+	const String path_b = "res://pck_collision/B@.txt";
+	REQUIRE(path_a.hash() == path_b.hash());
+
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	const String source_a = cache_path.path_join("pck_collision_a.txt");
+	const String source_b = cache_path.path_join("pck_collision_b.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_a, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("first");
+		f = FileAccess::open(source_b, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("second");
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = cache_path.path_join("output_collision.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file(path_a, source_a) == OK);
+	REQUIRE(pck_packer.add_file(path_b, source_b) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, false, 0) == OK);
+
+	Ref<FileAccess> f = PackedData::get_singleton()->try_open_path(path_a);
+	REQUIRE(f.is_valid());
+	CHECK_MESSAGE(f->get_as_text() == "first", "The first file should be found under its own path.");
+	f = PackedData::get_singleton()->try_open_path(path_b);
+	REQUIRE(f.is_valid());
+	CHECK_MESSAGE(f->get_as_text() == "second", "The second file should be found under its own path.");
+	CHECK_MESSAGE(!PackedData::get_singleton()->has_path("res://pck_collision/Ab.txt"), "Other paths shouldn't be found.");
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
@@ -31,6 +31,7 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -110,6 +111,122 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Loading a binary resource with many sub-resources") {
+	// Big enough for the sub-resources to be decoded on multiple threads, when available.
+	const int child_count = 16;
+	const int floats_per_child = 8192;
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Root");
+	Array children;
+	Ref<Resource> previous;
+	for (int i = 0; i < child_count; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name("Child " + itos(i));
+		PackedFloat32Array data;
+		data.resize(floats_per_child);
+		for (int j = 0; j < floats_per_child; j++) {
+			data.set(j, i * floats_per_child + j);
+		}
+		child->set_meta("data", data);
+		if (previous.is_valid()) {
+			Dictionary links;
+			Array previous_array;
+			previous_array.push_back(previous);
+			links[previous] = previous_array;
+			child->set_meta("links", links);
+		}
+		children.push_back(child);
+		previous = child;
+	}
+	resource->set_meta("children", children);
+
+	// Compressed files are decoded the same way, their chunks are decompressed one at a time.
+	for (const bool compress : { false, true }) {
+		const String save_path_binary = OS::get_singleton()->get_cache_path().path_join(compress ? "resource_many_compressed.res" : "resource_many.res");
+		ResourceSaver::save(resource, save_path_binary, compress ? ResourceSaver::FLAG_COMPRESS : ResourceSaver::FLAG_NONE);
+
+		Ref<Resource> loaded = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		Array loaded_children = loaded->get_meta("children");
+		REQUIRE(loaded_children.size() == child_count);
+
+		bool data_matches = true;
+		for (int i = 0; i < child_count; i++) {
+			Ref<Resource> child = loaded_children[i];
+			REQUIRE(child.is_valid());
+			CHECK(child->get_name() == "Child " + itos(i));
+
+			PackedFloat32Array data = child->get_meta("data");
+			REQUIRE(data.size() == floats_per_child);
+			for (int j = 0; j < floats_per_child; j++) {
+				data_matches = data_matches && data[j] == i * floats_per_child + j;
+			}
+
+			if (i > 0) {
+				Dictionary links = child->get_meta("links");
+				REQUIRE(links.size() == 1);
+				Ref<Resource> key = links.keys()[0];
+				Array value = links.values()[0];
+				CHECK_MESSAGE(key == loaded_children[i - 1], "References to other sub-resources should be resolved, also as dictionary keys.");
+				CHECK_MESSAGE(Ref<Resource>(value[0]) == loaded_children[i - 1], "References to other sub-resources should be resolved inside arrays.");
+			}
+		}
+		CHECK(data_matches);
+	}
+}
+
+TEST_CASE("[Resource] Saving a binary resource in the background") {
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Root");
+	Ref<Resource> child = memnew(Resource);
+	child->set_name("Child");
+	Array values;
+	values.push_back(1);
+	child->set_meta("values", values);
+	resource->set_meta("child", child);
+
+	const String save_path_binary = OS::get_singleton()->get_cache_path().path_join("resource_background.res");
+
+	CHECK(ResourceSaver::save_in_background(resource, save_path_binary, ResourceSaver::FLAG_NONE, true) == OK);
+	// Changes made after the snapshot was taken must not end up in the file.
+	values.push_back(2);
+	child->set_name("Changed child");
+	CHECK(ResourceSaver::wait_for_background_save(save_path_binary) == OK);
+
+	Ref<Resource> loaded = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	Ref<Resource> loaded_child = loaded->get_meta("child");
+	REQUIRE(loaded_child.is_valid());
+	CHECK(loaded_child->get_name() == "Child");
+	CHECK(Array(loaded_child->get_meta("values")).size() == 1);
+
+	CHECK(ResourceSaver::save_in_background(resource, save_path_binary, ResourceSaver::FLAG_NONE, true) == OK);
+	CHECK(ResourceSaver::wait_for_background_save(save_path_binary) == OK);
+
+	// Unchanged since the last save, so this one must not touch the file.
+	{
+		Ref<FileAccess> f = FileAccess::open(save_path_binary, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("untouched");
+	}
+	CHECK(ResourceSaver::save_in_background(resource, save_path_binary, ResourceSaver::FLAG_NONE, true) == OK);
+	CHECK(ResourceSaver::wait_for_background_save(save_path_binary) == OK);
+	CHECK_MESSAGE(FileAccess::get_file_as_string(save_path_binary) == "untouched", "Saving an unchanged resource should be skipped.");
+
+	// Changing a sub-resource is picked up.
+	child->set_name("Changed again");
+	CHECK(ResourceSaver::save_in_background(resource, save_path_binary, ResourceSaver::FLAG_NONE, true) == OK);
+	CHECK(ResourceSaver::wait_for_background_save(save_path_binary) == OK);
+
+	loaded = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	loaded_child = loaded->get_meta("child");
+	REQUIRE(loaded_child.is_valid());
+	CHECK(loaded_child->get_name() == "Changed again");
+	CHECK(Array(loaded_child->get_meta("values")).size() == 2);
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
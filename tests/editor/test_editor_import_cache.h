@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  test_editor_import_cache.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_IMPORT_CACHE_H
+#define TEST_EDITOR_IMPORT_CACHE_H
+
+#ifdef TOOLS_ENABLED
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "editor/import/editor_import_cache.h"
+#include "editor/import/resource_importer_image.h"
+
+#include "tests/test_macros.h"
+
+namespace TestEditorImportCache {
+
+static void write_file(const String &p_path, const String &p_text) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_text);
+}
+
+TEST_CASE("[EditorImportCache] Imports are fetched on hits and keyed by source contents") {
+	const String root = OS::get_singleton()->get_cache_path().path_join("editor_import_cache");
+	const String cache_path = root.path_join("cache");
+	const String source = root.path_join("icon.png");
+	const String base_from = root.path_join("from").path_join("icon.png-1234");
+	const String base_to = root.path_join("to").path_join("icon.png-1234");
+	REQUIRE(DirAccess::make_dir_recursive_absolute(base_from.get_base_dir()) == OK);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(base_to.get_base_dir()) == OK);
+
+	Ref<ResourceImporterImage> importer;
+	importer.instantiate();
+	List<ResourceImporter::ImportOption> options;
+	HashMap<StringName, Variant> params;
+
+	write_file(source, "first");
+	const String key = EditorImportCache::get_key(source, importer, options, params);
+	CHECK(!key.is_empty());
+
+	List<String> variants;
+	Variant metadata;
+	CHECK_MESSAGE(!EditorImportCache::fetch(cache_path, key, base_to, &variants, &metadata), "Nothing is stored yet, so this is a miss.");
+
+	write_file(base_from + ".image", "imported");
+	write_file(base_from + ".stale.image", "left over from another import");
+	Dictionary stored_metadata;
+	stored_metadata["vram_texture"] = false;
+	CHECK(EditorImportCache::store(cache_path, key, base_from, "image", List<String>(), stored_metadata));
+	CHECK_MESSAGE(!EditorImportCache::store(cache_path, key, base_from, "image", List<String>(), stored_metadata), "Entries are only stored once.");
+
+	CHECK(EditorImportCache::fetch(cache_path, key, base_to, &variants, &metadata));
+	CHECK(FileAccess::get_file_as_string(base_to + ".image") == "imported");
+	CHECK_MESSAGE(!FileAccess::exists(base_to + ".stale.image"), "Only the files the importer reported are cached.");
+	CHECK(variants.is_empty());
+	CHECK(metadata == Variant(stored_metadata));
+
+	write_file(source, "second");
+	const String changed_key = EditorImportCache::get_key(source, importer, options, params);
+	CHECK(changed_key != key);
+	CHECK_MESSAGE(!EditorImportCache::fetch(cache_path, changed_key, base_to, &variants, &metadata), "Changing the source is a miss.");
+
+	// Imports with variants store one file per variant.
+	List<String> stored_variants;
+	stored_variants.push_back("s3tc");
+	stored_variants.push_back("etc2");
+	write_file(base_from + ".s3tc.image", "s3tc");
+	write_file(base_from + ".etc2.image", "etc2");
+	CHECK(EditorImportCache::store(cache_path, changed_key, base_from, "image", stored_variants, Variant()));
+
+	variants.clear();
+	CHECK(EditorImportCache::fetch(cache_path, changed_key, base_to, &variants, &metadata));
+	CHECK(variants.size() == 2);
+	CHECK(FileAccess::get_file_as_string(base_to + ".s3tc.image") == "s3tc");
+	CHECK(FileAccess::get_file_as_string(base_to + ".etc2.image") == "etc2");
+
+	Ref<DirAccess> da = DirAccess::open(root);
+	REQUIRE(da.is_valid());
+	da->erase_contents_recursive();
+	DirAccess::remove_absolute(root);
+}
+
+} // namespace TestEditorImportCache
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_EDITOR_IMPORT_CACHE_H
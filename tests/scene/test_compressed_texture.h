@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  test_compressed_texture.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPRESSED_TEXTURE_H
+#define TEST_COMPRESSED_TEXTURE_H
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "scene/resources/compressed_texture.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCompressedTexture {
+
+static void write_streamable_ctex(const String &p_path, int p_size) {
+	Ref<Image> image = Image::create_empty(p_size, p_size, true, Image::FORMAT_RGBA8);
+	image->fill(Color(1, 0, 0));
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_8('G');
+	f->store_8('S');
+	f->store_8('T');
+	f->store_8('2');
+	f->store_32(CompressedTexture2D::FORMAT_VERSION);
+	f->store_32(p_size);
+	f->store_32(p_size);
+	f->store_32(CompressedTexture2D::FORMAT_BIT_STREAM | CompressedTexture2D::FORMAT_BIT_HAS_MIPMAPS);
+	f->store_32(0); // Mipmap limit.
+	f->store_32(0);
+	f->store_32(0);
+	f->store_32(0);
+
+	f->store_32(CompressedTexture2D::DATA_FORMAT_IMAGE);
+	f->store_16(p_size);
+	f->store_16(p_size);
+	f->store_32(image->get_mipmap_count());
+	f->store_32(image->get_format());
+	f->store_buffer(image->get_data());
+}
+
+static int get_texture_memory(const Ref<CompressedTexture2D> &p_texture) {
+	List<RS::TextureInfo> infos;
+	RS::get_singleton()->texture_debug_usage(&infos);
+	for (const RS::TextureInfo &info : infos) {
+		if (info.texture == p_texture->get_rid()) {
+			return info.bytes;
+		}
+	}
+	return 0;
+}
+
+TEST_CASE("[SceneTree][CompressedTexture2D] Mipmap streaming") {
+	const String path_a = OS::get_singleton()->get_cache_path().path_join("stream_a.ctex");
+	const String path_b = OS::get_singleton()->get_cache_path().path_join("stream_b.ctex");
+	write_streamable_ctex(path_a, 512);
+	write_streamable_ctex(path_b, 512);
+
+	const Variant old_min_size = GLOBAL_GET("rendering/textures/streaming/min_size");
+	const Variant old_budget = GLOBAL_GET("rendering/textures/streaming/memory_budget_mb");
+	ProjectSettings::get_singleton()->set_setting("rendering/textures/streaming/min_size", 64);
+	// A full 512×512 RGBA8 texture with mipmaps takes about 1.33 MiB, so only one fits.
+	ProjectSettings::get_singleton()->set_setting("rendering/textures/streaming/memory_budget_mb", 2);
+
+	const uint64_t initial_usage = CompressedTexture2D::get_stream_memory_usage();
+
+	Ref<CompressedTexture2D> texture_a;
+	texture_a.instantiate();
+	REQUIRE(texture_a->load(path_a) == OK);
+	Ref<CompressedTexture2D> texture_b;
+	texture_b.instantiate();
+	REQUIRE(texture_b->load(path_b) == OK);
+
+	SUBCASE("Only the low mipmaps are loaded initially") {
+		CHECK(texture_a->get_width() == 512);
+		CHECK(texture_a->get_stream_size() == 64);
+		CHECK(RS::get_singleton()->texture_2d_get(texture_a->get_rid())->get_width() == 64);
+
+		const int low_size = Image::get_image_data_size(64, 64, Image::FORMAT_RGBA8, true);
+		CHECK(get_texture_memory(texture_a) == low_size);
+		CHECK(CompressedTexture2D::get_stream_memory_usage() - initial_usage == uint64_t(low_size * 2));
+	}
+
+	SUBCASE("Requesting a size loads the matching mipmaps") {
+		texture_a->request_stream_size(200);
+		CHECK(texture_a->get_stream_size() == 256);
+		CHECK(get_texture_memory(texture_a) == Image::get_image_data_size(256, 256, Image::FORMAT_RGBA8, true));
+
+		// Smaller requests keep the resident mipmaps.
+		texture_a->request_stream_size(32);
+		CHECK(texture_a->get_stream_size() == 256);
+
+		texture_a->request_stream_size(4096);
+		CHECK(texture_a->get_stream_size() == 512);
+		CHECK(get_texture_memory(texture_a) == Image::get_image_data_size(512, 512, Image::FORMAT_RGBA8, true));
+	}
+
+	SUBCASE("Exceeding the memory budget evicts the least recently requested texture") {
+		texture_a->request_stream_size(512);
+		CHECK(texture_a->get_stream_size() == 512);
+
+		texture_b->request_stream_size(512);
+		CHECK(texture_b->get_stream_size() == 512);
+		CHECK(texture_a->get_stream_size() == 64);
+		CHECK(get_texture_memory(texture_a) == Image::get_image_data_size(64, 64, Image::FORMAT_RGBA8, true));
+		CHECK(CompressedTexture2D::get_stream_memory_usage() - initial_usage <= uint64_t(2 * 1024 * 1024));
+	}
+
+	texture_a.unref();
+	texture_b.unref();
+	CHECK(CompressedTexture2D::get_stream_memory_usage() == initial_usage);
+
+	ProjectSettings::get_singleton()->set_setting("rendering/textures/streaming/min_size", old_min_size);
+	ProjectSettings::get_singleton()->set_setting("rendering/textures/streaming/memory_budget_mb", old_budget);
+	DirAccess::remove_absolute(path_a);
+	DirAccess::remove_absolute(path_b);
+}
+
+} // namespace TestCompressedTexture
+
+#endif // TEST_COMPRESSED_TEXTURE_H
@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  test_importer_mesh.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_IMPORTER_MESH_H
+#define TEST_IMPORTER_MESH_H
+
+#include "scene/resources/importer_mesh.h"
+#include "scene/resources/primitive_meshes.h"
+#include "scene/resources/surface_tool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestImporterMesh {
+
+template <typename T>
+Array get_primitive_arrays() {
+	Ref<T> primitive;
+	primitive.instantiate();
+	return primitive->get_mesh_arrays();
+}
+
+TEST_CASE("[SceneTree][ImporterMesh] Content hash") {
+	Ref<ImporterMesh> mesh_a;
+	mesh_a.instantiate();
+	Ref<ImporterMesh> mesh_b;
+	mesh_b.instantiate();
+
+	Array sphere = get_primitive_arrays<SphereMesh>();
+	mesh_a->add_surface(Mesh::PRIMITIVE_TRIANGLES, sphere);
+	mesh_b->add_surface(Mesh::PRIMITIVE_TRIANGLES, sphere);
+	CHECK_MESSAGE(mesh_a->get_content_hash() == mesh_b->get_content_hash(), "Meshes with the same content should have the same hash.");
+
+	mesh_b->set_surface_material(0, memnew(StandardMaterial3D));
+	CHECK_MESSAGE(mesh_a->get_content_hash() == mesh_b->get_content_hash(), "Materials don't affect LOD generation and shouldn't change the hash.");
+
+	Array moved = sphere.duplicate();
+	PackedVector3Array vertices = moved[RS::ARRAY_VERTEX];
+	vertices.set(0, vertices[0] + Vector3(0, 1, 0));
+	moved[RS::ARRAY_VERTEX] = vertices;
+	mesh_b->clear();
+	mesh_b->add_surface(Mesh::PRIMITIVE_TRIANGLES, moved);
+	CHECK_MESSAGE(mesh_a->get_content_hash() != mesh_b->get_content_hash(), "Changing a vertex should change the hash.");
+}
+
+TEST_CASE("[SceneTree][ImporterMesh] LOD generation and cache data") {
+	Array sphere = get_primitive_arrays<SphereMesh>();
+	Array capsule = get_primitive_arrays<CapsuleMesh>();
+
+	Ref<ImporterMesh> mesh;
+	mesh.instantiate();
+	mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, sphere);
+	mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, capsule);
+	mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, sphere);
+	mesh->generate_lods(60.0f, 25.0f, Array());
+	mesh->create_shadow_mesh();
+
+	if (SurfaceTool::simplify_with_attrib_func) {
+		CHECK(mesh->get_surface_lod_count(0) > 0);
+		CHECK(mesh->get_surface_lod_count(1) > 0);
+	}
+
+	SUBCASE("Surfaces are simplified independently of each other") {
+		Ref<ImporterMesh> single;
+		single.instantiate();
+		single->add_surface(Mesh::PRIMITIVE_TRIANGLES, sphere);
+		single->generate_lods(60.0f, 25.0f, Array());
+
+		for (int surface : { 0, 2 }) {
+			REQUIRE(mesh->get_surface_lod_count(surface) == single->get_surface_lod_count(0));
+			for (int i = 0; i < single->get_surface_lod_count(0); i++) {
+				CHECK(mesh->get_surface_lod_size(surface, i) == single->get_surface_lod_size(0, i));
+				CHECK(mesh->get_surface_lod_indices(surface, i) == single->get_surface_lod_indices(0, i));
+			}
+		}
+	}
+
+	SUBCASE("Cache data restores LODs and the shadow mesh") {
+		Ref<ImporterMesh> restored;
+		restored.instantiate();
+		restored->add_surface(Mesh::PRIMITIVE_TRIANGLES, sphere);
+		restored->add_surface(Mesh::PRIMITIVE_TRIANGLES, capsule);
+		restored->add_surface(Mesh::PRIMITIVE_TRIANGLES, sphere);
+		CHECK(restored->set_lod_cache_data(mesh->get_lod_cache_data()));
+
+		for (int surface = 0; surface < mesh->get_surface_count(); surface++) {
+			Array arrays = restored->get_surface_arrays(surface);
+			Array expected_arrays = mesh->get_surface_arrays(surface);
+			CHECK(PackedVector3Array(arrays[RS::ARRAY_VERTEX]) == PackedVector3Array(expected_arrays[RS::ARRAY_VERTEX]));
+			REQUIRE(restored->get_surface_lod_count(surface) == mesh->get_surface_lod_count(surface));
+			for (int i = 0; i < mesh->get_surface_lod_count(surface); i++) {
+				CHECK(restored->get_surface_lod_size(surface, i) == mesh->get_surface_lod_size(surface, i));
+				CHECK(restored->get_surface_lod_indices(surface, i) == mesh->get_surface_lod_indices(surface, i));
+			}
+		}
+
+		CHECK(restored->get_shadow_mesh().is_valid() == mesh->get_shadow_mesh().is_valid());
+	}
+
+	SUBCASE("Cache data for a different surface layout is rejected") {
+		Ref<ImporterMesh> other;
+		other.instantiate();
+		other->add_surface(Mesh::PRIMITIVE_TRIANGLES, sphere);
+
+		ERR_PRINT_OFF;
+		CHECK_FALSE(other->set_lod_cache_data(mesh->get_lod_cache_data()));
+		ERR_PRINT_ON;
+		CHECK(other->get_surface_lod_count(0) == 0);
+	}
+}
+
+TEST_CASE("[SceneTree][ImporterMesh] Split into clusters") {
+	if (!SurfaceTool::build_meshlets_func) {
+		return;
+	}
+
+	Array sphere = get_primitive_arrays<SphereMesh>();
+	Array box = get_primitive_arrays<BoxMesh>();
+	int sphere_triangles = PackedInt32Array(sphere[RS::ARRAY_INDEX]).size() / 3;
+
+	Ref<ImporterMesh> mesh;
+	mesh.instantiate();
+	mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, box, Array(), Dictionary(), Ref<Material>(), "Box");
+	mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, sphere, Array(), Dictionary(), Ref<Material>(), "Sphere");
+
+	CHECK_MESSAGE(mesh->split_into_clusters(sphere_triangles).is_empty(), "Nothing should be split when all surfaces are small enough.");
+
+	Vector<Ref<ImporterMesh>> clusters = mesh->split_into_clusters(1024);
+	REQUIRE(clusters.size() > 2);
+
+	CHECK_MESSAGE(clusters[0]->get_surface_count() == 1, "Small surfaces should be kept in the first mesh.");
+	CHECK(clusters[0]->get_surface_name(0) == "Box");
+
+	int total_triangles = 0;
+	for (int i = 1; i < clusters.size(); i++) {
+		REQUIRE(clusters[i]->get_surface_count() == 1);
+		CHECK(clusters[i]->get_surface_name(0) == "Sphere");
+		Array arrays = clusters[i]->get_surface_arrays(0);
+		int triangles = PackedInt32Array(arrays[RS::ARRAY_INDEX]).size() / 3;
+		CHECK(triangles <= 1024);
+		CHECK(PackedVector3Array(arrays[RS::ARRAY_NORMAL]).size() == PackedVector3Array(arrays[RS::ARRAY_VERTEX]).size());
+		total_triangles += triangles;
+	}
+	CHECK_MESSAGE(total_triangles == sphere_triangles, "Every triangle should end up in exactly one cluster.");
+}
+
+} // namespace TestImporterMesh
+
+#endif // TEST_IMPORTER_MESH_H
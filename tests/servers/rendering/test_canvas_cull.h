@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  test_canvas_cull.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CANVAS_CULL_H
+#define TEST_CANVAS_CULL_H
+
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCanvasCull {
+
+static uint64_t _time_render_canvas(RendererCanvasCull::Canvas *p_canvas, int p_frames) {
+	const uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_frames; i++) {
+		RSG::canvas->render_canvas(RID(), p_canvas, Transform2D(), nullptr, nullptr, Rect2(0, 0, 1920, 1080), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xffffffff);
+	}
+	return OS::get_singleton()->get_ticks_usec() - start;
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Cull a wide canvas item subtree with the dummy renderer") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	const RID canvas = rs->canvas_create();
+	const RID root = rs->canvas_item_create();
+	rs->canvas_item_set_parent(root, canvas);
+
+	// Half of the sprites are off-screen, and a few items draw multimeshes, whose rects come from storage.
+	const int item_count = 50000;
+	LocalVector<RID> items;
+	const RID multimesh = rs->multimesh_create();
+	for (int i = 0; i < item_count; i++) {
+		const RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, root);
+		const Vector2 position((i % 250) * 16, (i / 250) * 16);
+		if (i % 1000 == 0) {
+			rs->canvas_item_add_multimesh(item, multimesh);
+		} else {
+			rs->canvas_item_add_rect(item, Rect2(position, Size2(16, 16)), Color(1, 1, 1));
+		}
+		items.push_back(item);
+	}
+
+	RendererCanvasCull::Canvas *canvas_ptr = RSG::canvas->canvas_owner.get_or_null(canvas);
+	REQUIRE(canvas_ptr);
+
+	const int frames = 10;
+	RSG::canvas->set_threaded_cull_minimum_children(UINT32_MAX);
+	_time_render_canvas(canvas_ptr, 1); // Warm up caches and sort the children once.
+	const uint64_t serial_usec = _time_render_canvas(canvas_ptr, frames);
+
+	RSG::canvas->set_threaded_cull_minimum_children(GLOBAL_GET("rendering/limits/canvas_cull/threaded_cull_minimum_children"));
+	const uint64_t threaded_usec = _time_render_canvas(canvas_ptr, frames);
+
+	MESSAGE(vformat("Culling %d canvas items: %d usec per frame serially, %d usec per frame on worker threads.", item_count, serial_usec / frames, threaded_usec / frames));
+
+	// Items changed between frames still get their rects refreshed before the workers run.
+	rs->canvas_item_clear(items[0]);
+	rs->canvas_item_add_multimesh(items[0], multimesh);
+	_time_render_canvas(canvas_ptr, 1);
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+	if (multimesh.is_valid()) { // The dummy storage doesn't allocate multimeshes.
+		rs->free(multimesh);
+	}
+	rs->free(root);
+	rs->free(canvas);
+}
+
+} // namespace TestCanvasCull
+
+#endif // TEST_CANVAS_CULL_H